@@ -46,11 +46,18 @@
 #include "map/tiles.h"
 
 #define BUILDING_ARRAY_SIZE_STEP 2000
+#define BUILDING_STATES (BUILDING_STATE_MOTHBALLED + 1)
 
 static struct {
     array(building) buildings;
     building *first_of_type[BUILDING_TYPE_MAX];
     building *last_of_type[BUILDING_TYPE_MAX];
+    building *first_burning_ruin;
+    building *last_burning_ruin;
+    // Main buildings linked in the type lists, per type and state
+    int counts[BUILDING_TYPE_MAX][BUILDING_STATES];
+    int state_totals[BUILDING_STATES];
+    unsigned int version;
 } data;
 
 static struct {
@@ -148,8 +155,111 @@ building *building_next(building *b)
     return array_item(data.buildings, b->next_part_building_id);
 }
 
+static void add_burning_ruin(building *b)
+{
+    building *prev = data.last_burning_ruin;
+    while (prev && prev->id > b->id) {
+        prev = prev->prev_burning;
+    }
+    b->prev_burning = prev;
+    b->next_burning = prev ? prev->next_burning : data.first_burning_ruin;
+    if (b->next_burning) {
+        b->next_burning->prev_burning = b;
+    } else {
+        data.last_burning_ruin = b;
+    }
+    if (prev) {
+        prev->next_burning = b;
+    } else {
+        data.first_burning_ruin = b;
+    }
+}
+
+void building_remove_burning_ruin(building *b)
+{
+    if (!b->prev_burning && data.first_burning_ruin != b) {
+        return;
+    }
+    if (b->prev_burning) {
+        b->prev_burning->next_burning = b->next_burning;
+    } else {
+        data.first_burning_ruin = b->next_burning;
+    }
+    if (b->next_burning) {
+        b->next_burning->prev_burning = b->prev_burning;
+    } else {
+        data.last_burning_ruin = b->prev_burning;
+    }
+    b->prev_burning = 0;
+    b->next_burning = 0;
+}
+
+building *building_first_burning_ruin(void)
+{
+    return data.first_burning_ruin;
+}
+
+static int is_counted(const building *b)
+{
+    // Out of range states can only come from corrupt or modded saves
+    return b->prev_part_building_id <= 0 && b->state < BUILDING_STATES;
+}
+
+static void add_to_counts(const building *b)
+{
+    data.version++;
+    if (is_counted(b)) {
+        data.counts[b->type][b->state]++;
+        data.state_totals[b->state]++;
+    }
+}
+
+static void remove_from_counts(const building *b)
+{
+    data.version++;
+    if (is_counted(b)) {
+        data.counts[b->type][b->state]--;
+        data.state_totals[b->state]--;
+    }
+}
+
+int building_count_in_state(building_type type, int state)
+{
+    return data.counts[type][state];
+}
+
+int building_count_all_in_state(int state)
+{
+    return data.state_totals[state];
+}
+
+unsigned int building_version(void)
+{
+    return data.version;
+}
+
+void building_set_state(building *b, int state)
+{
+    remove_from_counts(b);
+    b->state = state;
+    add_to_counts(b);
+}
+
+void building_set_previous_part(building *b, int prev_part_building_id)
+{
+    remove_from_counts(b);
+    b->prev_part_building_id = prev_part_building_id;
+    add_to_counts(b);
+}
+
 static void fill_adjacent_types(building *b)
 {
+    add_to_counts(b);
+    b->prev_burning = 0;
+    b->next_burning = 0;
+    if (b->type == BUILDING_BURNING_RUIN && b->state != BUILDING_STATE_RUBBLE) {
+        add_burning_ruin(b);
+    }
     building *first = data.first_of_type[b->type];
     building *last = data.last_of_type[b->type];
     if (!first || !last) {
@@ -185,6 +295,8 @@ static void fill_adjacent_types(building *b)
 
 static void remove_adjacent_types(building *b)
 {
+    remove_from_counts(b);
+    building_remove_burning_ruin(b);
     building *first = data.first_of_type[b->type];
     building *last = data.last_of_type[b->type];
     if (b == first && b == last) {
@@ -369,7 +481,10 @@ void building_clear_related_data(building *b)
 building *building_restore_from_undo(building *to_restore)
 {
     building *b = array_item(data.buildings, to_restore->id);
+    building_remove_burning_ruin(b);
     memcpy(b, to_restore, sizeof(building));
+    b->storage_resources.is_valid = 0;
+    b->storage_resources.has_totals = 0;
     if (b->id >= data.buildings.size) {
         data.buildings.size = b->id + 1;
     }
@@ -558,12 +673,12 @@ static int warehouse_repair(building *b)
     new_building->subtype.orientation = og_orientation;
     map_building_set_rubble_grid_building_id(standard_grid_offset, 0, 3); // remove rubble marker
     building_data_transfer_paste(new_building, 1);
-    new_building->state = BUILDING_STATE_CREATED;
+    building_set_state(new_building, BUILDING_STATE_CREATED);
     building_data_transfer_restore_and_clear_backup();
     figure_create_explosion_cloud(
         map_grid_offset_to_x(standard_grid_offset), map_grid_offset_to_y(standard_grid_offset), 3, 1);
 
-    b->state = BUILDING_STATE_DELETED_BY_GAME; // mark old building as deleted
+    building_set_state(b, BUILDING_STATE_DELETED_BY_GAME); // mark old building as deleted
     game_undo_disable(); // not accounting for undoing repairs
     return full_cost;
 }
@@ -667,8 +782,8 @@ int building_repair_at(int grid_offset)
     building_data_transfer_paste(new_building, 1);
     if (!building_properties_for_type(type_to_place)->shared) {
         new_building->subtype.orientation = og_orientation;
-        new_building->state = BUILDING_STATE_CREATED;
-        b->state = BUILDING_STATE_DELETED_BY_GAME; // mark old building as deleted
+        building_set_state(new_building, BUILDING_STATE_CREATED);
+        building_set_state(b, BUILDING_STATE_DELETED_BY_GAME); // mark old building as deleted
         figure_create_explosion_cloud(new_building->x, new_building->y, og_size, 1);
         if (building_variant_has_variants(new_building->type) || new_building->subtype.orientation) {
             map_building_tiles_add(new_building->id, new_building->x, new_building->y, new_building->size,
@@ -696,7 +811,7 @@ void building_update_state(void)
     array_foreach(data.buildings, b)
     {
         if (b->state == BUILDING_STATE_CREATED) {
-            b->state = BUILDING_STATE_IN_USE;
+            building_set_state(b, BUILDING_STATE_IN_USE);
         }
         if (b->state == BUILDING_STATE_IN_USE && b->house_size) {
             continue;
@@ -728,7 +843,7 @@ void building_update_state(void)
                 b->house_population = 0;
             }
             if (building_is_fort(b->type) || b->type == BUILDING_FORT_GROUND) {
-                b->state = BUILDING_STATE_DELETED_BY_GAME;
+                building_set_state(b, BUILDING_STATE_DELETED_BY_GAME);
                 map_building_tiles_remove(b->id, b->x, b->y);
                 map_building_set_rubble_grid_building_id(b->grid_offset, 0, b->size);
             }
@@ -937,10 +1052,10 @@ int building_is_fort(building_type type)
 int building_mothball_toggle(building *b)
 {
     if (b->state == BUILDING_STATE_IN_USE) {
-        b->state = BUILDING_STATE_MOTHBALLED;
+        building_set_state(b, BUILDING_STATE_MOTHBALLED);
         b->num_workers = 0;
     } else if (b->state == BUILDING_STATE_MOTHBALLED) {
-        b->state = BUILDING_STATE_IN_USE;
+        building_set_state(b, BUILDING_STATE_IN_USE);
     }
     return b->state;
 }
@@ -949,11 +1064,11 @@ int building_mothball_set(building *b, int mothball)
 {
     if (mothball) {
         if (b->state == BUILDING_STATE_IN_USE) {
-            b->state = BUILDING_STATE_MOTHBALLED;
+            building_set_state(b, BUILDING_STATE_MOTHBALLED);
             b->num_workers = 0;
         }
     } else if (b->state == BUILDING_STATE_MOTHBALLED) {
-        b->state = BUILDING_STATE_IN_USE;
+        building_set_state(b, BUILDING_STATE_IN_USE);
     }
     return b->state;
 
@@ -1042,6 +1157,11 @@ void building_clear_all(void)
 {
     memset(data.first_of_type, 0, sizeof(data.first_of_type));
     memset(data.last_of_type, 0, sizeof(data.last_of_type));
+    data.first_burning_ruin = 0;
+    data.last_burning_ruin = 0;
+    memset(data.counts, 0, sizeof(data.counts));
+    memset(data.state_totals, 0, sizeof(data.state_totals));
+    data.version++;
 
     if (!array_init(data.buildings, BUILDING_ARRAY_SIZE_STEP, initialize_new_building, building_in_use) ||
         !array_next(data.buildings)) { // Ignore first building
@@ -1107,6 +1227,11 @@ void building_load_state(buffer *buf, buffer *sequence, buffer *corrupt_houses,
 
     memset(data.first_of_type, 0, sizeof(data.first_of_type));
     memset(data.last_of_type, 0, sizeof(data.last_of_type));
+    data.first_burning_ruin = 0;
+    data.last_burning_ruin = 0;
+    memset(data.counts, 0, sizeof(data.counts));
+    memset(data.state_totals, 0, sizeof(data.state_totals));
+    data.version++;
 
     int highest_id_in_use = 0;
 
@@ -7,6 +7,8 @@
 #include "game/resource.h"
 #include "translation/translation.h"
 
+#include <stdint.h>
+
 #define BUILDING_WATER_DESIRABILITY_RANGE 3
 #define BUILDING_WATER_DESIRABILITY_BONUS 15
 
@@ -33,6 +35,9 @@ typedef struct building {
     struct building *prev_of_type;
     struct building *next_of_type;
 
+    struct building *prev_burning;
+    struct building *next_burning;
+
     time_millis last_update;
 
     unsigned char state;
@@ -207,6 +212,15 @@ typedef struct building {
     unsigned char has_latrines_access;
     short resources[RESOURCE_MAX];
     unsigned char accepted_goods[RESOURCE_MAX];
+    struct {
+        uint64_t in_stock;
+        uint64_t with_room;
+        unsigned char is_valid;
+        // Warehouses only: the number of spaces holding each resource, RESOURCE_NONE for empty spaces.
+        // Together with resources[] these are running totals, valid while has_totals is set
+        unsigned char spaces[RESOURCE_MAX];
+        unsigned char has_totals;
+    } storage_resources; // not saved
 } building;
 
 building *building_get(unsigned int id);
@@ -226,8 +240,55 @@ int building_can_repair_type(building_type type);
 
 building *building_first_of_type(building_type type);
 
+/**
+ * Returns the first burning ruin. Burning ruins are linked in id order through next_burning
+ * @return The first burning ruin, or 0 if nothing is burning
+ */
+building *building_first_burning_ruin(void);
+
+/**
+ * Unlinks a ruin that stopped burning from the burning ruins
+ * @param b The ruin
+ */
+void building_remove_burning_ruin(building *b);
+
 void building_change_type(building *b, building_type type);
 
+/**
+ * Changes the state of a building, keeping the building counts up to date
+ * @param b The building
+ * @param state The new state
+ */
+void building_set_state(building *b, int state);
+
+/**
+ * Links a building to the previous part of a multi-part building, keeping the building counts up to date
+ * @param b The building
+ * @param prev_part_building_id Id of the previous part, or 0 if the building is the main part
+ */
+void building_set_previous_part(building *b, int prev_part_building_id);
+
+/**
+ * Returns the number of main buildings of the type in the given state
+ * @param type Building type
+ * @param state Building state
+ * @return Number of buildings
+ */
+int building_count_in_state(building_type type, int state);
+
+/**
+ * Returns the number of main buildings of any type in the given state
+ * @param state Building state
+ * @return Number of buildings
+ */
+int building_count_all_in_state(int state);
+
+/**
+ * Returns a number that changes whenever a building is added, removed or changes state
+ * @return Building version
+ */
+unsigned int building_version(void);
+
 building *building_main(const building *b);
 
 building *building_next(building *b);
@@ -305,7 +305,7 @@ static int place_houses(int measure_only, int x_start, int y_start, int x_end, i
         if (needs_road_warning) {
             city_warning_show(WARNING_HOUSE_TOO_FAR_FROM_ROAD, NEW_WARNING_SLOT);
         }
-        map_routing_update_land();
+        map_routing_update_land_area(x_min, y_min, x_max - x_min + 1, y_max - y_min + 1);
         window_invalidate();
     }
     return items_placed;
@@ -364,6 +364,9 @@ static int place_garden(int x_start, int y_start, int x_end, int y_end, int is_o
         }
     }
     map_tiles_update_all_gardens();
+    if (!measure_only) {
+        map_routing_update_land_area(x_min, y_min, x_max - x_min + 1, y_max - y_min + 1);
+    }
     return items_placed;
 }
 
@@ -1233,10 +1236,8 @@ void building_construction_place(void)
         placement_cost *= place_plaza(x_start, y_start, x_end, y_end);
     } else if (type == BUILDING_GARDENS) {
         placement_cost *= place_garden(x_start, y_start, x_end, y_end, 0, 0);
-        map_routing_update_land();
     } else if (type == BUILDING_OVERGROWN_GARDENS) {
         placement_cost *= place_garden(x_start, y_start, x_end, y_end, 1, 0);
-        map_routing_update_land();
     } else if (type == BUILDING_LOW_BRIDGE) {
         int length = map_bridge_add(x_end, y_end, 0);
         if (length <= 1) {
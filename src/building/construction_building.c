@@ -81,7 +81,7 @@ static void set_cleared_tile_backup_to_grass(int grid_offset)
 
 static void add_fort(int type, building *fort)
 {
-    fort->prev_part_building_id = 0;
+    building_set_previous_part(fort, 0);
     map_building_tiles_add(fort->id, fort->x, fort->y, fort->size, building_image_get(fort), TERRAIN_BUILDING);
     if (type == BUILDING_FORT_LEGIONARIES) {
         fort->subtype.fort_figure_type = FIGURE_FORT_LEGIONARY;
@@ -103,7 +103,7 @@ static void add_fort(int type, building *fort)
         fort->y + offsets_y[building_rotation_get_rotation()]);
     game_undo_add_building(ground);
     fort = building_get(id);
-    ground->prev_part_building_id = fort->id;
+    building_set_previous_part(ground, fort->id);
     fort->next_part_building_id = ground->id;
     ground->next_part_building_id = 0;
     map_building_tiles_add(ground->id, fort->x + offsets_x[building_rotation_get_rotation()],
@@ -240,7 +240,8 @@ void building_construction_auto_clear_finalize(void)
         map_tiles_update_region_empty_land(
             auto_clear_state.min_x, auto_clear_state.min_y,
             auto_clear_state.max_x, auto_clear_state.max_y);
-        map_routing_update_land();
+        map_routing_update_land_area(auto_clear_state.min_x, auto_clear_state.min_y,
+            auto_clear_state.max_x - auto_clear_state.min_x + 1, auto_clear_state.max_y - auto_clear_state.min_y + 1);
         auto_clear_state.pending = 0;
     }
 }
@@ -273,11 +274,11 @@ static void add_hippodrome(building *b)
     building *part3 = building_create(BUILDING_HIPPODROME, part1->x + x_offset, part1->y + y_offset);
     game_undo_add_building(part3);
 
-    part1->prev_part_building_id = 0;
+    building_set_previous_part(part1, 0);
     part1->next_part_building_id = part2->id;
-    part2->prev_part_building_id = part1->id;
+    building_set_previous_part(part2, part1->id);
     part2->next_part_building_id = part3->id;
-    part3->prev_part_building_id = part2->id;
+    building_set_previous_part(part3, part2->id);
     part3->next_part_building_id = 0;
 }
 
@@ -286,7 +287,7 @@ static int add_warehouse_space(int x, int y, int prev_id)
     building *b = building_create(BUILDING_WAREHOUSE_SPACE, x, y);
     game_undo_add_building(b);
     building *prev = building_get(prev_id);
-    b->prev_part_building_id = prev->id;
+    building_set_previous_part(b, prev->id);
     prev->next_part_building_id = b->id;
     map_building_tiles_add(b->id, x, y, 1,
         image_group(GROUP_BUILDING_WAREHOUSE_STORAGE_EMPTY), TERRAIN_BUILDING);
@@ -296,7 +297,7 @@ static int add_warehouse_space(int x, int y, int prev_id)
 static void add_warehouse(building *b, int orientation)
 {
     b->storage_id = building_storage_create(b->id);
-    b->prev_part_building_id = 0;
+    building_set_previous_part(b, 0);
     // assert orientation. orientation points to the tower's location (0-3), out of 4 possible corners
     b->subtype.orientation = orientation;
 
@@ -358,9 +359,11 @@ static void add_to_map(int type, building *b, int size, int orientation, int wat
     if (building_variant_has_variants(b->type)) {
         b->variant = building_rotation_get_rotation_with_limit(building_variant_get_number_of_variants(b->type));
     }
+    int footprint_only = 0;
     switch (type) {
         default:
             add_building(b);
+            footprint_only = 1;
             break;
             // entertainment
         case BUILDING_COLOSSEUM:
@@ -526,7 +529,12 @@ static void add_to_map(int type, building *b, int size, int orientation, int wat
             add_building(b);
             break;
     }
-    map_routing_update_land();
+    if (footprint_only) {
+        // Plain buildings only change the routing of their own tiles
+        map_routing_update_land_area(b->x, b->y, b->size, b->size);
+    } else {
+        map_routing_update_land();
+    }
     map_routing_update_walls();
 }
 
@@ -553,6 +561,7 @@ int building_construction_is_warehouse_corner(int tile_no)
 int building_construction_fill_vacant_lots(grid_slice *area)
 {
     int items_placed = 0;
+    int x_min = 0, y_min = 0, x_max = 0, y_max = 0;
     for (int i = 0; i < area->size; i++) {
         int grid_offset = area->grid_offsets[i];
         int x = map_grid_offset_to_x(grid_offset);
@@ -563,11 +572,23 @@ int building_construction_fill_vacant_lots(grid_slice *area)
         }
         building *b = building_get(map_building_at(grid_offset));
         game_undo_add_building(b);
+        if (!items_placed || x < x_min) {
+            x_min = x;
+        }
+        if (!items_placed || y < y_min) {
+            y_min = y;
+        }
+        if (!items_placed || x > x_max) {
+            x_max = x;
+        }
+        if (!items_placed || y > y_max) {
+            y_max = y;
+        }
         items_placed++;
     }
     if (items_placed > 0) {
         building_construction_warning_check_food_stocks(BUILDING_HOUSE_VACANT_LOT);
-        map_routing_update_land();
+        map_routing_update_land_area(x_min, y_min, x_max - x_min + 1, y_max - y_min + 1);
     }
     return items_placed;
 }
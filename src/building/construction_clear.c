@@ -172,7 +172,7 @@ static unsigned int clear_land_confirmed(int x_start, int y_start, int x_end, in
                     items_placed++;
                     game_undo_add_building(b);
                 }
-                b->state = BUILDING_STATE_DELETED_BY_PLAYER;
+                building_set_state(b, BUILDING_STATE_DELETED_BY_PLAYER);
                 b->is_deleted = 1;
                 building *space = b;
                 for (int i = 0; i < 9; i++) {
@@ -181,7 +181,7 @@ static unsigned int clear_land_confirmed(int x_start, int y_start, int x_end, in
                     }
                     space = building_get(space->prev_part_building_id);
                     game_undo_add_building(space);
-                    space->state = BUILDING_STATE_DELETED_BY_PLAYER;
+                    building_set_state(space, BUILDING_STATE_DELETED_BY_PLAYER);
                 }
                 space = b;
                 for (int i = 0; i < 9; i++) {
@@ -190,7 +190,7 @@ static unsigned int clear_land_confirmed(int x_start, int y_start, int x_end, in
                         break;
                     }
                     game_undo_add_building(space);
-                    space->state = BUILDING_STATE_DELETED_BY_PLAYER;
+                    building_set_state(space, BUILDING_STATE_DELETED_BY_PLAYER);
                 }
             } else if (map_terrain_is(grid_offset, TERRAIN_AQUEDUCT)) {
                 map_terrain_remove(grid_offset, TERRAIN_CLEARABLE & ~TERRAIN_HIGHWAY);
@@ -225,13 +225,13 @@ static unsigned int clear_land_confirmed(int x_start, int y_start, int x_end, in
                                 rubble_building->type == BUILDING_BURNING_RUIN) {
                                 int ruins_left = map_building_ruins_left(rubble_id);
                                 if (!ruins_left) { //dont remove buildings until their last rubble is gone
-                                    rubble_building->state = BUILDING_STATE_DELETED_BY_GAME;
+                                    building_set_state(rubble_building, BUILDING_STATE_DELETED_BY_GAME);
                                 }
                             } else if (rubble_building->state == BUILDING_STATE_UNUSED) {
                                 // intentional fallthrough - unused buildings are corrupt if they exist on the grid. 
                                 // dont change state, just remove reference on the grid - addressed after if {} block 
                             } else {
-                                rubble_building->state = BUILDING_STATE_DELETED_BY_GAME;
+                                building_set_state(rubble_building, BUILDING_STATE_DELETED_BY_GAME);
                             }
                         }
                     }
@@ -261,7 +261,8 @@ static unsigned int clear_land_confirmed(int x_start, int y_start, int x_end, in
     map_tiles_update_area_highways(x_min - 1, y_min - 1, radius);
     map_tiles_update_all_plazas();
     map_tiles_update_region_aqueducts(x_min - 3, y_min - 3, x_max + 3, y_max + 3);
-    map_routing_update_land();
+    // Aqueduct routing depends on the tile images, which were updated three tiles around the area
+    map_routing_update_land_area(x_min - 3, y_min - 3, x_max - x_min + 7, y_max - y_min + 7);
     map_routing_update_walls();
     map_routing_update_water();
     building_update_state(); // the update of b state is needed to determine the right images for walls/palisades
@@ -121,6 +121,10 @@ int building_count_active(building_type type)
     if (building_is_fort(type)) {
         return count_forts_per_type(type, 1);
     }
+    // Activity depends on workers, water and residents, so only buildings in use need to be checked
+    if (!building_count_in_state(type, BUILDING_STATE_IN_USE)) {
+        return 0;
+    }
     int active = 0;
     for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
         if (building_is_active(b) && b == building_main(b)) {
@@ -138,32 +142,23 @@ int building_count_total(building_type type)
     if (building_is_fort(type)) {
         return count_forts_per_type(type, 0);
     }
-    int total = 0;
-    for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-        if ((b->state == BUILDING_STATE_IN_USE || b->state == BUILDING_STATE_CREATED ||
-            b->state == BUILDING_STATE_MOTHBALLED) && b == building_main(b)) {
-            total++;
-        }
-    }
-    return total;
+    return building_count_in_state(type, BUILDING_STATE_IN_USE) +
+        building_count_in_state(type, BUILDING_STATE_CREATED) +
+        building_count_in_state(type, BUILDING_STATE_MOTHBALLED);
 }
 
 int building_count_any_total(int active_only)
 {
+    if (!active_only) {
+        return building_count_all_in_state(BUILDING_STATE_IN_USE) +
+            building_count_all_in_state(BUILDING_STATE_CREATED) +
+            building_count_all_in_state(BUILDING_STATE_MOTHBALLED);
+    }
     int total = 0;
     for (int id = 1; id < building_count(); id++) {
         building *b = building_get(id);
-        if (b == building_main(b)) {
-            if (active_only) {
-                if (building_is_active(b)) {
-                    total++;
-                }
-            } else {
-                if (b->state == BUILDING_STATE_IN_USE || b->state == BUILDING_STATE_CREATED ||
-                    b->state == BUILDING_STATE_MOTHBALLED) {
-                    total++;
-                }
-            }
+        if (b == building_main(b) && building_is_active(b)) {
+            total++;
         }
     }
     return total;
@@ -171,6 +166,10 @@ int building_count_any_total(int active_only)
 
 int building_count_upgraded(building_type type)
 {
+    if (!building_count_in_state(type, BUILDING_STATE_IN_USE) &&
+        !building_count_in_state(type, BUILDING_STATE_CREATED)) {
+        return 0;
+    }
     int upgraded = 0;
     for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
         if ((b->state == BUILDING_STATE_IN_USE || b->state == BUILDING_STATE_CREATED) && b->upgrade_level > 0 && b == building_main(b)) {
@@ -433,6 +432,9 @@ int building_count_forts(int active_only)
 
 int building_count_terrain_in_area(int minx, int miny, int maxx, int maxy, int terrain, int (*condition)(int))
 {
+    if (!condition) {
+        return map_terrain_count_tiles_in_area(terrain, minx, miny, maxx - 1, maxy - 1);
+    }
     int total = 0;
     int grid_offset;
     for (int y = miny; y < maxy; y++) {
@@ -458,6 +460,9 @@ static void get_min_map_xy(void)
 
 int building_count_terrain(int terrain, int (*condition)(int))
 {
+    if (!condition) {
+        return map_terrain_count_tiles(terrain);
+    }
     get_min_map_xy();
     return building_count_terrain_in_area(min_x, min_y, min_x + map_data.width, min_y + map_data.height, terrain, condition);
 }
@@ -119,6 +119,7 @@ figure_type building_count_forts_get_figure_type_from_building(building_type typ
 
 /**
  * Special counting functions for buildings which are special
+ * Passing a NULL condition uses the live terrain counts instead of scanning the map
  */
 int building_count_terrain_in_area(int minx, int miny, int maxx, int maxy, int terrain, int (*condition)(int));
 int building_count_terrain(int terrain, int (*condition)(int));
@@ -43,7 +43,7 @@ static void destroy_without_rubble(building *b)
     building_clear_related_data(b);
 
     map_building_tiles_remove(b->id, b->x, b->y);
-    b->state = BUILDING_STATE_DELETED_BY_GAME;
+    building_set_state(b, BUILDING_STATE_DELETED_BY_GAME);
 }
 
 static void destroy_on_fire(building *b, int plagued)
@@ -85,7 +85,7 @@ static void destroy_on_fire(building *b, int plagued)
     }
     map_building_tiles_remove(b->id, b->x, b->y);
     if (map_terrain_is(b->grid_offset, TERRAIN_WATER)) {
-        b->state = BUILDING_STATE_RUBBLE;
+        building_set_state(b, BUILDING_STATE_RUBBLE);
     } else {
         building_change_type(b, BUILDING_BURNING_RUIN);
     }
@@ -152,11 +152,11 @@ static void destroy_linked_parts(building *b, int destruction_method, int plague
                 destroy_on_fire(part, plagued);
                 break;
             case DESTROY_EARTHQUAKE:
-                part->state = BUILDING_STATE_DELETED_BY_GAME;
+                building_set_state(part, BUILDING_STATE_DELETED_BY_GAME);
                 break;
             default:
                 map_building_tiles_set_rubble(part_id, part->x, part->y, part->size);
-                part->state = BUILDING_STATE_RUBBLE;
+                building_set_state(part, BUILDING_STATE_RUBBLE);
                 break;
         }
     }
@@ -176,11 +176,11 @@ static void destroy_linked_parts(building *b, int destruction_method, int plague
                 destroy_on_fire(part, plagued);
                 break;
             case DESTROY_EARTHQUAKE:
-                part->state = BUILDING_STATE_DELETED_BY_GAME;
+                building_set_state(part, BUILDING_STATE_DELETED_BY_GAME);
                 break;
             default:
                 map_building_tiles_set_rubble(part_id, part->x, part->y, part->size);
-                part->state = BUILDING_STATE_RUBBLE;
+                building_set_state(part, BUILDING_STATE_RUBBLE);
         }
     }
 
@@ -192,7 +192,7 @@ static void destroy_linked_parts(building *b, int destruction_method, int plague
         for (int i = 0; i < 9 && part->id > 0; i++) {
             building *next_part = building_next(part);
             part->next_part_building_id = 0;
-            part->prev_part_building_id = 0;
+            building_set_previous_part(part, 0);
             part = next_part;
         }
     }
@@ -205,7 +205,7 @@ void building_destroy_by_collapse(building *b)
         return;
     }
     game_undo_disable();
-    b->state = BUILDING_STATE_RUBBLE;
+    building_set_state(b, BUILDING_STATE_RUBBLE);
     if (b->type == BUILDING_TOWER) {
         figure_kill_tower_sentries_in_building(b);
     }
@@ -232,7 +232,7 @@ void building_destroy_by_earthquake(building *b)
     game_undo_disable();
     int grid_offset = b->grid_offset; // save before destroying building
     int size = b->size;
-    b->state = BUILDING_STATE_DELETED_BY_GAME;
+    building_set_state(b, BUILDING_STATE_DELETED_BY_GAME);
     map_building_tiles_set_rubble(b->id, b->x, b->y, b->size);
     destroy_linked_parts(b, DESTROY_EARTHQUAKE, 0);
     map_building_set_rubble_grid_building_id(grid_offset, 0, size);
@@ -166,16 +166,6 @@ static int is_invalid_destination(building *b, int permission, int road_network)
         !building_storage_get_permission(permission, b));
 }
 
-static int is_food_needed(const resource_storage_info info[RESOURCE_MAX])
-{
-    for (resource_type r = RESOURCE_MIN_FOOD; r < RESOURCE_MAX_FOOD; r++) {
-        if (info[r].needed) {
-            return 1;
-        }
-    }
-    return 0;
-}
-
 static int get_resource_storages(resource_storage_info info[RESOURCE_MAX],
     building_type type, int road_network, int x, int y, int w, int h, int max_distance)
 {
@@ -184,31 +174,48 @@ static int get_resource_storages(resource_storage_info info[RESOURCE_MAX],
         info[r].building_id = 0;
     }
 
+    uint64_t needed_food = 0;
+    uint64_t needed_goods = 0;
+    for (resource_type r = RESOURCE_MIN_FOOD; r < RESOURCE_MAX_FOOD; r++) {
+        if (info[r].needed) {
+            needed_food |= BUILDING_STORAGE_RESOURCE_FLAG(r);
+        }
+    }
+    for (resource_type r = RESOURCE_MIN_NON_FOOD; r < RESOURCE_MAX_NON_FOOD; r++) {
+        if (resource_is_storable(r) && info[r].needed) {
+            needed_goods |= BUILDING_STORAGE_RESOURCE_FLAG(r);
+        }
+    }
+
     int permission = building_storage_get_permission_from_building_type(type);
-    if (is_food_needed(info)) {
+    if (needed_food) {
         for (building *b = building_first_of_type(BUILDING_GRANARY); b; b = b->next_of_type) {
+            uint64_t stocked = building_storage_resources_in_stock(b) & needed_food;
             // Looter walkers have no type
-            if (type && is_invalid_destination(b, permission, road_network)) {
+            if (!stocked || (type && is_invalid_destination(b, permission, road_network))) {
                 continue;
             }
             int distance = building_dist(x, y, w, h, b);
 
             for (int r = RESOURCE_MIN_FOOD; r < RESOURCE_MAX_FOOD; r++) {
-                if (info[r].needed) {
+                if (stocked & BUILDING_STORAGE_RESOURCE_FLAG(r)) {
                     update_food_resource(info, r, b, distance);
                 }
             }
         }
     }
-    for (building *b = building_first_of_type(BUILDING_WAREHOUSE); b; b = b->next_of_type) {
-        if (type && is_invalid_destination(b, permission, road_network)) {
-            continue;
-        }
-        int distance = building_dist(x, y, w, h, b);
+    if (needed_goods) {
+        for (building *b = building_first_of_type(BUILDING_WAREHOUSE); b; b = b->next_of_type) {
+            uint64_t stocked = building_storage_resources_in_stock(b) & needed_goods;
+            if (!stocked || (type && is_invalid_destination(b, permission, road_network))) {
+                continue;
+            }
+            int distance = building_dist(x, y, w, h, b);
 
-        for (resource_type r = RESOURCE_MIN_NON_FOOD; r < RESOURCE_MAX_NON_FOOD; r++) {
-            if (resource_is_storable(r) && info[r].needed) {
-                update_good_resource(info, r, b, distance);
+            for (resource_type r = RESOURCE_MIN_NON_FOOD; r < RESOURCE_MAX_NON_FOOD; r++) {
+                if (stocked & BUILDING_STORAGE_RESOURCE_FLAG(r)) {
+                    update_good_resource(info, r, b, distance);
+                }
             }
         }
     }
@@ -142,6 +142,7 @@ int building_granary_try_add_resource(building *granary, int resource, int amoun
         granary->resources[resource] += amount_added;
         granary->resources[RESOURCE_NONE] -= amount_added;
     }
+    building_storage_contents_changed(granary);
     return amount_added;
 }
 
@@ -177,6 +178,7 @@ int building_granary_try_remove_resource(building *granary, int resource, int de
     city_resource_remove_from_granary(resource, removed);
     granary->resources[resource] -= removed;
     granary->resources[RESOURCE_NONE] += removed;
+    building_storage_contents_changed(granary);
     return removed;
 }
 
@@ -673,6 +675,7 @@ void building_granary_update_built_granaries_capacity(void)
 
         if (total_units < BUILDING_STORAGE_QUANTITY_MAX) {
             b->resources[RESOURCE_NONE] += BUILDING_STORAGE_QUANTITY_MAX - total_units;
+            building_storage_contents_changed(b);
         }
         // for now, we don't handle the case where we decrease granary capacity
     }
@@ -102,7 +102,7 @@ static void prepare_for_merge(unsigned int building_id, int num_tiles)
                     merge_data.inventory[r] += house->resources[r];
                 }
                 house->house_population = 0;
-                house->state = BUILDING_STATE_DELETED_BY_GAME;
+                building_set_state(house, BUILDING_STATE_DELETED_BY_GAME);
             }
         }
     }
@@ -616,7 +616,7 @@ void building_house_check_for_corruption(building *house)
             }
         }
         building_totals_add_corrupted_house(1);
-        house->state = BUILDING_STATE_RUBBLE;
+        building_set_state(house, BUILDING_STATE_RUBBLE);
     }
 }
 
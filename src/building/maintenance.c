@@ -30,88 +30,157 @@
 #include "scenario/property.h"
 #include "sound/effect.h"
 
+typedef struct {
+    int x_min;
+    int y_min;
+    int x_max;
+    int y_max;
+} land_area;
+
 static struct {
     int fire_spread_direction;
     int obstruction_message_displayed;
 } data;
 
+static void clear_land_area(land_area *area)
+{
+    area->x_min = area->y_min = 0;
+    area->x_max = area->y_max = -1;
+}
+
+static void add_to_land_area(land_area *area, int x, int y, int size)
+{
+    if (area->x_max < area->x_min) {
+        area->x_min = x;
+        area->y_min = y;
+        area->x_max = x + size - 1;
+        area->y_max = y + size - 1;
+        return;
+    }
+    if (x < area->x_min) {
+        area->x_min = x;
+    }
+    if (y < area->y_min) {
+        area->y_min = y;
+    }
+    if (x + size - 1 > area->x_max) {
+        area->x_max = x + size - 1;
+    }
+    if (y + size - 1 > area->y_max) {
+        area->y_max = y + size - 1;
+    }
+}
+
+static void add_building_to_land_area(land_area *area, building *b)
+{
+    // Destroying a building also destroys all of its linked parts, so include them
+    building *part = b;
+    for (int guard = 0; guard < 64 && part->prev_part_building_id > 0; guard++) {
+        part = building_get(part->prev_part_building_id);
+    }
+    for (int guard = 0; guard < 64 && part->id > 0; guard++) {
+        add_to_land_area(area, part->x, part->y, part->size);
+        part = building_next(part);
+    }
+}
+
+static void update_land_area(const land_area *area)
+{
+    if (area->x_max >= area->x_min) {
+        map_routing_update_land_area(area->x_min, area->y_min,
+            area->x_max - area->x_min + 1, area->y_max - area->y_min + 1);
+    }
+}
+
 void building_maintenance_update_fire_direction(void)
 {
     data.fire_spread_direction = random_byte() & 7;
 }
 
-void building_maintenance_update_burning_ruins(void)
+static void update_burning_ruin(building *b, scenario_climate climate, land_area *changed_land)
 {
-    scenario_climate climate = scenario_property_climate();
-    int recalculate_terrain = 0;
-    building_list_burning_clear();
-    for (int i = 1; i < building_count(); i++) {
-        building *b = building_get(i);
-        if ((b->state != BUILDING_STATE_IN_USE && b->state != BUILDING_STATE_MOTHBALLED) ||
-            b->type != BUILDING_BURNING_RUIN) {
-            continue;
-        }
-        if (b->fire_duration < 0) {
-            b->fire_duration = 0;
-        }
-        b->fire_duration++;
-        if (b->fire_duration > 32) {
-            game_undo_disable();
-            b->state = BUILDING_STATE_RUBBLE;
-            map_building_tiles_set_rubble(i, b->x, b->y, b->size);
-            recalculate_terrain = 1;
-            continue;
-        }
-        if (b->has_plague) {
-            continue;
-        }
-        building_list_burning_add(i);
-        if (climate == CLIMATE_DESERT) {
-            if (b->fire_duration & 3) { // check spread every 4 ticks
-                continue;
-            }
-        } else {
-            if (b->fire_duration & 7) { // check spread every 8 ticks
-                continue;
-            }
-        }
-        if ((b->house_figure_generation_delay & 3) != (random_byte() & 3)) {
-            continue;
-        }
-        int dir1 = data.fire_spread_direction - 1;
-        if (dir1 < 0) {
-            dir1 = 7;
+    if (b->fire_duration < 0) {
+        b->fire_duration = 0;
+    }
+    b->fire_duration++;
+    if (b->fire_duration > 32) {
+        game_undo_disable();
+        building_set_state(b, BUILDING_STATE_RUBBLE);
+        map_building_tiles_set_rubble(b->id, b->x, b->y, b->size);
+        add_to_land_area(changed_land, b->x, b->y, b->size);
+        return;
+    }
+    if (b->has_plague) {
+        return;
+    }
+    building_list_burning_add(b->id);
+    if (climate == CLIMATE_DESERT) {
+        if (b->fire_duration & 3) { // check spread every 4 ticks
+            return;
         }
-        int dir2 = data.fire_spread_direction + 1;
-        if (dir2 > 7) {
-            dir2 = 0;
+    } else {
+        if (b->fire_duration & 7) { // check spread every 8 ticks
+            return;
         }
+    }
+    if ((b->house_figure_generation_delay & 3) != (random_byte() & 3)) {
+        return;
+    }
+    int dir1 = data.fire_spread_direction - 1;
+    if (dir1 < 0) {
+        dir1 = 7;
+    }
+    int dir2 = data.fire_spread_direction + 1;
+    if (dir2 > 7) {
+        dir2 = 0;
+    }
 
-        int grid_offset = b->grid_offset;
-        int next_building_id = map_building_at(grid_offset + map_grid_direction_delta(data.fire_spread_direction));
+    int grid_offset = b->grid_offset;
+    int next_building_id = map_building_at(grid_offset + map_grid_direction_delta(data.fire_spread_direction));
+    if (next_building_id && !building_get(next_building_id)->fire_proof) {
+        building *next_building = building_get(next_building_id);
+        add_building_to_land_area(changed_land, next_building);
+        building_destroy_by_fire(next_building);
+        sound_effect_play(SOUND_EFFECT_EXPLOSION);
+    } else {
+        next_building_id = map_building_at(grid_offset + map_grid_direction_delta(dir1));
         if (next_building_id && !building_get(next_building_id)->fire_proof) {
-            building_destroy_by_fire(building_get(next_building_id));
+            building *next_building = building_get(next_building_id);
+            add_building_to_land_area(changed_land, next_building);
+            building_destroy_by_fire(next_building);
             sound_effect_play(SOUND_EFFECT_EXPLOSION);
-            recalculate_terrain = 1;
         } else {
-            next_building_id = map_building_at(grid_offset + map_grid_direction_delta(dir1));
+            next_building_id = map_building_at(grid_offset + map_grid_direction_delta(dir2));
             if (next_building_id && !building_get(next_building_id)->fire_proof) {
-                building_destroy_by_fire(building_get(next_building_id));
+                building *next_building = building_get(next_building_id);
+                add_building_to_land_area(changed_land, next_building);
+                building_destroy_by_fire(next_building);
                 sound_effect_play(SOUND_EFFECT_EXPLOSION);
-                recalculate_terrain = 1;
-            } else {
-                next_building_id = map_building_at(grid_offset + map_grid_direction_delta(dir2));
-                if (next_building_id && !building_get(next_building_id)->fire_proof) {
-                    building_destroy_by_fire(building_get(next_building_id));
-                    sound_effect_play(SOUND_EFFECT_EXPLOSION);
-                    recalculate_terrain = 1;
-                }
             }
         }
     }
-    if (recalculate_terrain) {
-        map_routing_update_land();
+}
+
+void building_maintenance_update_burning_ruins(void)
+{
+    scenario_climate climate = scenario_property_climate();
+    land_area changed_land;
+    clear_land_area(&changed_land);
+    building_list_burning_clear();
+    building *b = building_first_burning_ruin();
+    while (b) {
+        if (b->state == BUILDING_STATE_IN_USE || b->state == BUILDING_STATE_MOTHBALLED) {
+            update_burning_ruin(b, climate, &changed_land);
+        }
+        // Only read the next ruin now: ruins started by this pass are linked in id order and get updated too
+        building *next = b->next_burning;
+        if (b->state != BUILDING_STATE_CREATED && b->state != BUILDING_STATE_IN_USE &&
+            b->state != BUILDING_STATE_MOTHBALLED) {
+            building_remove_burning_ruin(b);
+        }
+        b = next;
     }
+    update_land_area(&changed_land);
 }
 
 int building_maintenance_get_closest_burning_ruin(int x, int y, int *distance)
@@ -172,7 +241,8 @@ void building_maintenance_check_fire_collapse(void)
     city_sentiment_reset_protesters_criminals();
 
     scenario_climate climate = scenario_property_climate();
-    int recalculate_terrain = 0;
+    land_area changed_land;
+    clear_land_area(&changed_land);
     int random_global = random_byte() & 7;
     if (city_population() < 10) {
         return; // skip fire/collapse checks in very early game to avoid frustrating the player
@@ -195,8 +265,8 @@ void building_maintenance_check_fire_collapse(void)
             b->damage_risk = 0;
         }
         if (b->damage_risk > 200) {
+            add_building_to_land_area(&changed_land, b);
             collapse_building(b);
-            recalculate_terrain = 1;
             continue;
         }
         // fire
@@ -225,14 +295,12 @@ void building_maintenance_check_fire_collapse(void)
             b->fire_risk += fire_increase;
         }
         if (b->fire_risk > 100) {
+            add_building_to_land_area(&changed_land, b);
             fire_building(b);
-            recalculate_terrain = 1;
         }
     }
 
-    if (recalculate_terrain) {
-        map_routing_update_land();
-    }
+    update_land_area(&changed_land);
 }
 
 void building_maintenance_check_rome_access(void)
@@ -259,7 +327,7 @@ void building_maintenance_check_rome_access(void)
                         b->house_population = 0;
                         b->house_unreachable_ticks = 0;
                     }
-                    b->state = BUILDING_STATE_UNDO;
+                    building_set_state(b, BUILDING_STATE_UNDO);
                 }
             } else {
                 int distance = map_routing_distance(map_grid_offset(x_road, y_road));
@@ -279,7 +347,7 @@ void building_maintenance_check_rome_access(void)
                     b->house_unreachable_ticks++;
                     if (b->house_unreachable_ticks > 8) {
                         b->house_unreachable_ticks = 0;
-                        b->state = BUILDING_STATE_UNDO;
+                        building_set_state(b, BUILDING_STATE_UNDO);
                     }
                 }
                 b->road_access_x = x_road;
@@ -187,15 +187,35 @@ static const monument_type *MONUMENT_TYPES[BUILDING_TYPE_MAX] = {
     [BUILDING_TRIUMPHAL_ARCH]       = &triumphal_arch
 };
 
-typedef struct {
+typedef struct monument_delivery {
     int walker_id;
     unsigned int destination_id;
     int resource;
     int cartloads;
+    struct monument_delivery *next_of_walker; // not saved
 } monument_delivery;
 
+typedef struct {
+    unsigned int monument_id;
+    int deliveries;
+    int cartloads[RESOURCE_MAX];
+} delivery_totals;
+
 array(monument_delivery) monument_deliveries;
 
+// Lookups derived from monument_deliveries, rebuilt whenever the deliveries are initialized or loaded
+static struct {
+    struct {
+        delivery_totals *items; // open addressing by monument id
+        unsigned int capacity;
+        unsigned int used;
+    } totals;
+    struct {
+        monument_delivery **first; // first delivery of each walker, by figure id
+        unsigned int capacity;
+    } walkers;
+} delivery_lookup;
+
 int building_monument_deliver_resource(building *b, int resource)
 {
     if (b->id <= 0 || !building_monument_is_monument(b) ||
@@ -532,11 +552,140 @@ static int delivery_in_use(const monument_delivery *delivery)
     return delivery->destination_id != 0;
 }
 
+static delivery_totals *find_totals(delivery_totals *items, unsigned int capacity, unsigned int monument_id)
+{
+    unsigned int mask = capacity - 1;
+    unsigned int index = (monument_id * 2654435761u) & mask;
+    while (items[index].monument_id && items[index].monument_id != monument_id) {
+        index = (index + 1) & mask;
+    }
+    return &items[index];
+}
+
+static int grow_totals(void)
+{
+    unsigned int capacity = delivery_lookup.totals.capacity ? delivery_lookup.totals.capacity * 2 : 16;
+    delivery_totals *items = calloc(capacity, sizeof(delivery_totals));
+    if (!items) {
+        return 0;
+    }
+    for (unsigned int i = 0; i < delivery_lookup.totals.capacity; i++) {
+        const delivery_totals *totals = &delivery_lookup.totals.items[i];
+        if (totals->monument_id) {
+            *find_totals(items, capacity, totals->monument_id) = *totals;
+        }
+    }
+    free(delivery_lookup.totals.items);
+    delivery_lookup.totals.items = items;
+    delivery_lookup.totals.capacity = capacity;
+    return 1;
+}
+
+static delivery_totals *get_totals(unsigned int monument_id, int create)
+{
+    if (delivery_lookup.totals.capacity) {
+        delivery_totals *totals =
+            find_totals(delivery_lookup.totals.items, delivery_lookup.totals.capacity, monument_id);
+        if (totals->monument_id || !create) {
+            return totals->monument_id ? totals : 0;
+        }
+    }
+    if (!create) {
+        return 0;
+    }
+    // Entries are never removed, monuments that ever had deliveries are few
+    if (2 * (delivery_lookup.totals.used + 1) > delivery_lookup.totals.capacity && !grow_totals()) {
+        return 0;
+    }
+    delivery_totals *totals = find_totals(delivery_lookup.totals.items, delivery_lookup.totals.capacity, monument_id);
+    totals->monument_id = monument_id;
+    delivery_lookup.totals.used++;
+    return totals;
+}
+
+static monument_delivery **get_walker_deliveries(int walker_id, int create)
+{
+    if (walker_id <= 0) {
+        return 0;
+    }
+    if ((unsigned int) walker_id >= delivery_lookup.walkers.capacity) {
+        if (!create) {
+            return 0;
+        }
+        unsigned int capacity = delivery_lookup.walkers.capacity ? delivery_lookup.walkers.capacity : 256;
+        while (capacity <= (unsigned int) walker_id) {
+            capacity *= 2;
+        }
+        monument_delivery **first = realloc(delivery_lookup.walkers.first, capacity * sizeof(monument_delivery *));
+        if (!first) {
+            return 0;
+        }
+        memset(&first[delivery_lookup.walkers.capacity], 0,
+            (capacity - delivery_lookup.walkers.capacity) * sizeof(monument_delivery *));
+        delivery_lookup.walkers.first = first;
+        delivery_lookup.walkers.capacity = capacity;
+    }
+    return &delivery_lookup.walkers.first[walker_id];
+}
+
+static void update_totals(const monument_delivery *delivery, int sign)
+{
+    delivery_totals *totals = get_totals(delivery->destination_id, sign > 0);
+    if (!totals) {
+        return;
+    }
+    totals->deliveries += sign;
+    if (delivery->resource >= 0 && delivery->resource < RESOURCE_MAX) {
+        totals->cartloads[delivery->resource] += sign * delivery->cartloads;
+    }
+}
+
+static void add_to_lookup(monument_delivery *delivery)
+{
+    update_totals(delivery, 1);
+    monument_delivery **first = get_walker_deliveries(delivery->walker_id, 1);
+    if (first) {
+        delivery->next_of_walker = *first;
+        *first = delivery;
+    } else {
+        delivery->next_of_walker = 0;
+    }
+}
+
+static void remove_from_lookup(monument_delivery *delivery)
+{
+    update_totals(delivery, -1);
+    monument_delivery **link = get_walker_deliveries(delivery->walker_id, 0);
+    while (link && *link) {
+        if (*link == delivery) {
+            *link = delivery->next_of_walker;
+            break;
+        }
+        link = &(*link)->next_of_walker;
+    }
+    delivery->next_of_walker = 0;
+}
+
+static void rebuild_lookup(void)
+{
+    free(delivery_lookup.totals.items);
+    free(delivery_lookup.walkers.first);
+    memset(&delivery_lookup, 0, sizeof(delivery_lookup));
+
+    monument_delivery *delivery;
+    array_foreach(monument_deliveries, delivery) {
+        if (delivery_in_use(delivery)) {
+            add_to_lookup(delivery);
+        }
+    }
+}
+
 void building_monument_initialize_deliveries(void)
 {
     if (!array_init(monument_deliveries, DELIVERY_ARRAY_SIZE_STEP, 0, delivery_in_use)) {
         log_error("Failed to create monument array. The game will likely crash.", 0, 0);
     }
+    rebuild_lookup();
 }
 
 void building_monument_add_delivery(unsigned int monument_id, int figure_id, int resource_id, int num_loads)
@@ -551,46 +700,44 @@ void building_monument_add_delivery(unsigned int monument_id, int figure_id, int
     delivery->walker_id = figure_id;
     delivery->resource = resource_id;
     delivery->cartloads = num_loads;
+    add_to_lookup(delivery);
 }
 
 int building_monument_has_delivery_for_worker(int figure_id)
 {
-    monument_delivery *delivery;
-    array_foreach(monument_deliveries, delivery) {
-        if (delivery->walker_id == figure_id && delivery->destination_id > 0) {
-            return 1;
-        }
-    }
-    return 0;
+    monument_delivery **first = get_walker_deliveries(figure_id, 0);
+    return first && *first;
 }
 
 int building_monument_has_delivery_for_building(int monument_id)
 {
-    monument_delivery *delivery;
-    array_foreach(monument_deliveries, delivery) {
-        if (delivery->destination_id == monument_id) {
-            return 1;
-        }
-    }
-    return 0;
+    const delivery_totals *totals = get_totals(monument_id, 0);
+    return totals && totals->deliveries > 0;
 }
 
 void building_monument_remove_delivery(int figure_id)
 {
-    monument_delivery *delivery;
-    array_foreach(monument_deliveries, delivery) {
-        if (delivery->walker_id == figure_id) {
-            delivery->destination_id = 0;
-        }
+    monument_delivery **first = get_walker_deliveries(figure_id, 0);
+    if (!first) {
+        return;
+    }
+    while (*first) {
+        monument_delivery *delivery = *first;
+        remove_from_lookup(delivery);
+        delivery->destination_id = 0;
     }
     array_trim(monument_deliveries);
 }
 
 void building_monument_remove_all_deliveries(unsigned int monument_id)
 {
+    if (!building_monument_has_delivery_for_building(monument_id)) {
+        return;
+    }
     monument_delivery *delivery;
     array_foreach(monument_deliveries, delivery) {
         if (delivery->destination_id == monument_id) {
+            remove_from_lookup(delivery);
             delivery->destination_id = 0;
         }
     }
@@ -599,15 +746,11 @@ void building_monument_remove_all_deliveries(unsigned int monument_id)
 
 static int resource_in_delivery(unsigned int monument_id, int resource_id)
 {
-    int resources = 0;
-    monument_delivery *delivery;
-    array_foreach(monument_deliveries, delivery) {
-        if (delivery->destination_id == monument_id &&
-            delivery->resource == resource_id) {
-            resources += delivery->cartloads;
-        }
+    const delivery_totals *totals = get_totals(monument_id, 0);
+    if (!totals || resource_id < 0 || resource_id >= RESOURCE_MAX) {
+        return 0;
     }
-    return resources;
+    return totals->cartloads[resource_id];
 }
 
 static int resource_in_delivery_multipart(building *b, int resource_id)
@@ -619,13 +762,7 @@ static int resource_in_delivery_multipart(building *b, int resource_id)
     }
 
     while (b->id) {
-        monument_delivery *delivery;
-        array_foreach(monument_deliveries, delivery) {
-            if (delivery->destination_id == b->id &&
-                delivery->resource == resource_id) {
-                resources += delivery->cartloads;
-            }
-        }
+        resources += resource_in_delivery(b->id, resource_id);
         b = building_get(b->next_part_building_id);
     }
 
@@ -814,6 +951,7 @@ void building_monument_delivery_load_state(buffer *buf, int includes_delivery_bu
     for (int i = 0; i < deliveries_to_load; i++) {
         delivery_load(buf, array_next(monument_deliveries), delivery_buf_size);
     }
+    rebuild_lookup();
 }
 
 int building_monument_is_construction_halted(building *b)
@@ -824,10 +962,10 @@ int building_monument_is_construction_halted(building *b)
 int building_monument_toggle_construction_halted(building *b)
 {
     if (b->state == BUILDING_STATE_MOTHBALLED) {
-        b->state = BUILDING_STATE_IN_USE;
+        building_set_state(b, BUILDING_STATE_IN_USE);
         return 0;
     } else {
-        b->state = BUILDING_STATE_MOTHBALLED;
+        building_set_state(b, BUILDING_STATE_MOTHBALLED);
         return 1;
     }
 }
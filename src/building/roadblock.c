@@ -2,12 +2,14 @@
 
 #include "building/building.h"
 #include "building/type.h"
+#include "map/routing_terrain.h"
 
 void building_roadblock_set_permission(roadblock_permission p, building *b)
 {
     if (building_type_is_roadblock(b->type)) {
         int permission_bit = 1 << p;
         b->data.roadblock.exceptions ^= permission_bit;
+        map_routing_citizen_network_changed();
     }
 }
 
@@ -48,6 +50,7 @@ void building_roadblock_accept_none(building *b)
 {
     if (building_type_is_roadblock(b->type)) {
         b->data.roadblock.exceptions = 0;
+        map_routing_citizen_network_changed();
     }
 }
 
@@ -55,5 +58,6 @@ void building_roadblock_accept_all(building *b)
 {
     if (building_type_is_roadblock(b->type)) {
         b->data.roadblock.exceptions = ROADBLOCK_PERMISSION_ALL;
+        map_routing_citizen_network_changed();
     }
 }
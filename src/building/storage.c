@@ -198,6 +198,70 @@ int building_storage_get_amount(building *b, resource_type resource)
     return 0;
 }
 
+void building_storage_contents_changed(building *b)
+{
+    if (b->type == BUILDING_WAREHOUSE_SPACE) {
+        b = building_main(b);
+    }
+    b->storage_resources.is_valid = 0;
+}
+
+static void update_storage_resources(building *b)
+{
+    uint64_t in_stock = 0;
+    uint64_t with_room = 0;
+    if (b->type == BUILDING_GRANARY) {
+        for (resource_type r = RESOURCE_MIN_FOOD; r < RESOURCE_MAX_FOOD; r++) {
+            if (b->resources[r] > 0) {
+                in_stock |= BUILDING_STORAGE_RESOURCE_FLAG(r);
+            }
+            if (b->resources[RESOURCE_NONE] > 0) {
+                with_room |= BUILDING_STORAGE_RESOURCE_FLAG(r);
+            }
+        }
+    } else if (b->type == BUILDING_WAREHOUSE) {
+        building *space = b;
+        for (int i = 0; i < 8; i++) {
+            space = building_next(space);
+            if (space->id <= 0) {
+                break;
+            }
+            resource_type r = space->subtype.warehouse_resource_id;
+            if (r == RESOURCE_NONE) {
+                for (resource_type other = RESOURCE_MIN; other < RESOURCE_MAX; other++) {
+                    with_room |= BUILDING_STORAGE_RESOURCE_FLAG(other);
+                }
+                continue;
+            }
+            if (space->resources[r] > 0) {
+                in_stock |= BUILDING_STORAGE_RESOURCE_FLAG(r);
+            }
+            if (space->resources[r] < MAX_CARTLOADS_PER_SPACE) {
+                with_room |= BUILDING_STORAGE_RESOURCE_FLAG(r);
+            }
+        }
+    }
+    b->storage_resources.in_stock = in_stock;
+    b->storage_resources.with_room = with_room;
+    b->storage_resources.is_valid = 1;
+}
+
+uint64_t building_storage_resources_in_stock(building *b)
+{
+    if (!b->storage_resources.is_valid) {
+        update_storage_resources(b);
+    }
+    return b->storage_resources.in_stock;
+}
+
+uint64_t building_storage_resources_with_room(building *b)
+{
+    if (!b->storage_resources.is_valid) {
+        update_storage_resources(b);
+    }
+    return b->storage_resources.with_room;
+}
+
 int building_storage_get_storage_state_quantity(building *b, resource_type resource)
 {
     const building_storage *s = building_storage_get(b->storage_id);
@@ -708,6 +772,7 @@ void building_storage_load_state(buffer *buf, int version)
             granary_free_space -= b->resources[r];
         }
         b->resources[RESOURCE_NONE] = granary_free_space;
+        building_storage_contents_changed(b);
     }
 
     storages.size = highest_id_in_use + 1;
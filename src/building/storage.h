@@ -276,6 +276,28 @@ int building_storage_get_storage_state_quantity(building *b, resource_type resou
  */
 int building_storage_get_amount(building *b, resource_type resource);
 
+#define BUILDING_STORAGE_RESOURCE_FLAG(r) (((uint64_t) 1) << (r))
+
+/**
+ * Signals that the stored goods of a granary or warehouse changed. Must be called after every change.
+ * @param b The granary, the warehouse or one of its spaces
+ */
+void building_storage_contents_changed(building *b);
+
+/**
+ * Gets the resources a granary or warehouse holds at least some of, regardless of its settings
+ * @param b The granary or warehouse
+ * @return A mask of BUILDING_STORAGE_RESOURCE_FLAG values
+ */
+uint64_t building_storage_resources_in_stock(building *b);
+
+/**
+ * Gets the resources that still physically fit in a granary or warehouse, regardless of its settings
+ * @param b The granary or warehouse
+ * @return A mask of BUILDING_STORAGE_RESOURCE_FLAG values
+ */
+uint64_t building_storage_resources_with_room(building *b);
+
 void building_storage_toggle_permission(building_storage_permission_states p, building *b);
 int building_storage_get_permission(building_storage_permission_states p, building *b);
 void building_storage_set_permission(building_storage_permission_states p, building *b, int enable);
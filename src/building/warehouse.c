@@ -22,7 +22,6 @@
 #define INFINITE 10000
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
-#define MAX_CARTLOADS_PER_SPACE 4
 
 static void building_warehouse_space_set_image(building *space, int resource);
 
@@ -78,26 +77,65 @@ int building_warehouse_get_tower_grid_offset(building *warehouse)
     return tower->grid_offset;
 }
 
-int building_warehouse_get_amount(building *warehouse, int resource)
+static void remove_space_from_totals(building *main, const building *space)
 {
-    int loads = 0;
-    building *space = warehouse;
-    for (int i = 0; i < 8; i++) {
-        space = building_next(space);
-        if (space->id <= 0) {
-            return 0;
-        }
-        if (space->subtype.warehouse_resource_id && space->subtype.warehouse_resource_id == resource) {
-            loads += space->resources[resource];
-        }
+    if (!main->storage_resources.has_totals) {
+        return;
+    }
+    int resource = space->subtype.warehouse_resource_id;
+    main->storage_resources.spaces[resource]--;
+    if (resource != RESOURCE_NONE) {
+        main->resources[resource] -= space->resources[resource];
+        main->resources[RESOURCE_NONE] += space->resources[resource];
+    }
+}
+
+static void add_space_to_totals(building *main, const building *space)
+{
+    if (!main->storage_resources.has_totals) {
+        return;
+    }
+    int resource = space->subtype.warehouse_resource_id;
+    main->storage_resources.spaces[resource]++;
+    if (resource != RESOURCE_NONE) {
+        main->resources[resource] += space->resources[resource];
+        main->resources[RESOURCE_NONE] -= space->resources[resource];
+    }
+}
+
+static building *get_warehouse_with_totals(building *warehouse)
+{
+    building *main = building_main(warehouse);
+    if (main->type != BUILDING_WAREHOUSE) {
+        return 0;
     }
-    return loads;
+    if (!main->storage_resources.has_totals) {
+        building_warehouse_recount_resources(main);
+    }
+    return main;
+}
+
+int building_warehouse_get_amount(building *warehouse, int resource)
+{
+    building *main = get_warehouse_with_totals(warehouse);
+    return main ? main->resources[resource] : 0;
 }
 
 int building_warehouse_get_free_space_amount(building *warehouse)
 {
-    building_warehouse_recount_resources(warehouse); //recount, since free space in warehouse is tied to individual spaces
-    return warehouse->resources[RESOURCE_NONE];
+    building *main = get_warehouse_with_totals(warehouse);
+    return main ? main->resources[RESOURCE_NONE] : 0;
+}
+
+int building_warehouse_get_space_for_resource(building *warehouse, int resource)
+{
+    building *main = get_warehouse_with_totals(warehouse);
+    if (!main || !main->storage_resources.has_totals) {
+        // Incomplete warehouses do not accept goods
+        return 0;
+    }
+    int loads = MAX_CARTLOADS_PER_SPACE * main->storage_resources.spaces[resource];
+    return resource == RESOURCE_NONE ? loads : loads - main->resources[resource];
 }
 
 int building_warehouse_get_available_amount(building *warehouse, int resource)
@@ -172,21 +210,29 @@ void building_warehouse_recount_resources(building *main)
     // Reset all resource counters in the main warehouse
     for (int r = 0; r < RESOURCE_MAX; r++) {
         main->resources[r] = 0;
+        main->storage_resources.spaces[r] = 0;
     }
 
+    int has_all_spaces = 1;
     building *space = main;
     for (int i = 0; i < 8; i++) {
         space = building_next(space);
         if (space->id <= 0) {
+            has_all_spaces = 0;
             continue;
         }
 
         int resource = space->subtype.warehouse_resource_id;
         if (resource > RESOURCE_NONE && resource < RESOURCE_MAX) {
             main->resources[resource] += space->resources[resource];
+            main->storage_resources.spaces[resource]++;
+        } else {
+            main->storage_resources.spaces[RESOURCE_NONE]++;
         }
         building_warehouse_space_set_image(space, resource);
     }
+    // While the warehouse is incomplete, keep recounting until all its spaces exist
+    main->storage_resources.has_totals = has_all_spaces;
     // Total sum of all loads (regardless of type)
     int total_loads = 0;
     for (int r = 1; r < RESOURCE_MAX; r++) {
@@ -219,8 +265,11 @@ int building_warehouse_try_add_resource(building *b, int resource, int quantity,
         //we cannot mix multiple resources in one space either
         signed short to_add = ((quantity - added) < space_remaining) ? (quantity - added) : space_remaining;
 
+        building *main = building_main(space);
+        remove_space_from_totals(main, space);
         space->resources[resource] += to_add;
         space->subtype.warehouse_resource_id = resource;
+        add_space_to_totals(main, space);
         added += to_add;
 
         city_resource_add_to_warehouse(resource, to_add);
@@ -228,6 +277,7 @@ int building_warehouse_try_add_resource(building *b, int resource, int quantity,
     }
 
     if (added) {
+        building_storage_contents_changed(b);
         tutorial_on_add_to_warehouse();
     }
     return added;
@@ -264,7 +314,7 @@ int building_warehouse_try_remove_resource(building *warehouse, int resource, in
     building *space = warehouse;
     for (int i = 0; i < 8; i++) {
         if (remaining_desired <= 0) {
-            return removed_amount;
+            break;
         }
         space = building_next(space);
         if (space->id <= 0) {
@@ -273,6 +323,8 @@ int building_warehouse_try_remove_resource(building *warehouse, int resource, in
         if (space->subtype.warehouse_resource_id != resource || space->resources[resource] <= 0) {
             continue;
         }
+        building *main = building_main(space);
+        remove_space_from_totals(main, space);
         if (space->resources[resource] > remaining_desired) {
             removed_amount += remaining_desired;
             city_resource_remove_from_warehouse(resource, remaining_desired);
@@ -285,8 +337,12 @@ int building_warehouse_try_remove_resource(building *warehouse, int resource, in
             space->resources[resource] = 0;
             space->subtype.warehouse_resource_id = RESOURCE_NONE;
         }
+        add_space_to_totals(main, space);
         building_warehouse_space_set_image(space, resource);
     }
+    if (removed_amount) {
+        building_storage_contents_changed(warehouse);
+    }
     return removed_amount;
 }
 
@@ -296,6 +352,7 @@ void building_warehouse_remove_resource_curse(building *warehouse, int amount)
         return;
     }
 
+    building_storage_contents_changed(warehouse);
     building *space = warehouse;
     for (int i = 0; i < 8 && amount > 0; i++) {
         space = building_next(space);
@@ -303,6 +360,7 @@ void building_warehouse_remove_resource_curse(building *warehouse, int amount)
         if (space->id <= 0 || space->resources[resource] <= 0) {
             continue;
         }
+        remove_space_from_totals(warehouse, space);
         if (space->resources[resource] > amount) {
             city_resource_remove_from_warehouse(resource, amount);
             space->resources[resource] -= amount;
@@ -313,6 +371,7 @@ void building_warehouse_remove_resource_curse(building *warehouse, int amount)
             space->resources[resource] = 0;
             space->subtype.warehouse_resource_id = RESOURCE_NONE;
         }
+        add_space_to_totals(warehouse, space);
         building_warehouse_space_set_image(space, resource);
     }
 }
@@ -450,29 +509,11 @@ static int get_acceptable_quantity(building *b, int resource)
     }
 }
 
-static int building_warehouse_max_space_for_resource(building *b, int resource)
-{
-    // internal function to check space with respect to tiled storage - keep static
-    int max_storable = 0;
-    building *space = b;
-    for (int i = 0; i < 8; i++) {
-        space = building_next(space);
-        if (space->id <= 0) {
-            return 0;
-        }
-        if (space->subtype.warehouse_resource_id == resource) {
-            max_storable += MAX_CARTLOADS_PER_SPACE - space->resources[resource];
-        }
-        if (space->subtype.warehouse_resource_id == RESOURCE_NONE) {
-            max_storable += MAX_CARTLOADS_PER_SPACE;
-        }
-    }
-    return max_storable;
-}
-
 int building_warehouse_maximum_receptible_amount(building *warehouse, int resource)
 {
-    building_warehouse_recount_resources(warehouse);
+    if (!get_warehouse_with_totals(warehouse)) {
+        return 0;
+    }
     if (warehouse->has_plague || building_storage_get_empty_all(warehouse->id) ||
         warehouse->state != BUILDING_STATE_IN_USE || warehouse->resources[RESOURCE_NONE] <= 0) {
         return 0;
@@ -484,7 +525,8 @@ int building_warehouse_maximum_receptible_amount(building *warehouse, int resour
     unsigned char current_amount = building_warehouse_get_amount(warehouse, resource);
     unsigned char remaining_allowed = (max_allowed > current_amount) ? (max_allowed - current_amount) : 0;
 
-    unsigned char resource_space_limit = building_warehouse_max_space_for_resource(warehouse, resource); // max by tile layout
+    unsigned char resource_space_limit = building_warehouse_get_space_for_resource(warehouse, resource) +
+        building_warehouse_get_space_for_resource(warehouse, RESOURCE_NONE); // max by tile layout
     unsigned char free_space_overall = warehouse->resources[RESOURCE_NONE]; // total free space
 
     unsigned char available_space = MIN(free_space_overall, resource_space_limit); // tile storage and free space
@@ -611,7 +653,8 @@ int building_warehouse_accepts_storage(building *warehouse, int resource, int *u
         }
         return 0;
     }
-    if (building_warehouse_max_space_for_resource(warehouse, resource)) {
+    if (building_warehouse_get_space_for_resource(warehouse, resource) ||
+        building_warehouse_get_space_for_resource(warehouse, RESOURCE_NONE)) {
         return 1;
     }
     return 0;
@@ -743,7 +786,7 @@ int building_warehouse_determine_worker_task(building *warehouse, int *resource)
     if (pct_workers < 50) {
         return WAREHOUSE_TASK_NONE;
     }
-    building_warehouse_recount_resources(warehouse);
+    get_warehouse_with_totals(warehouse);
     building *space;
     //TASK 1: emptying takes priority
     if (building_storage_get_empty_all(warehouse->id)) {
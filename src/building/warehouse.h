@@ -9,6 +9,7 @@
 #define THREEQ_WAREHOUSE 24
 #define HALF_WAREHOUSE 16
 #define QUARTER_WAREHOUSE 8
+#define MAX_CARTLOADS_PER_SPACE 4
 
 enum {
   WAREHOUSE_REMOVING_RESOURCE = 0,
@@ -70,6 +71,14 @@ int building_warehouse_get_amount(building *warehouse, int resource);
  */
 int building_warehouse_get_free_space_amount(building *warehouse);
 
+/**
+ * @brief Get how many more loads of a resource fit in the spaces already holding it.
+ * @param warehouse Pointer to the warehouse building
+ * @param resource The resource type, or RESOURCE_NONE for the loads that fit in empty spaces
+ * @return Amount of loads
+ */
+int building_warehouse_get_space_for_resource(building *warehouse, int resource);
+
 /**
  * @brief Count available (deliverable) amount in a warehouse.
  * TODO: create building_storage helper for this and granary equivalent
@@ -143,6 +143,7 @@ void city_culture_update_coverage(void)
     int nymphaeums = building_count_active(BUILDING_NYMPHAEUM);
     int small_mausoleums = building_count_active(BUILDING_SMALL_MAUSOLEUM);
     int large_mausoleums = building_count_active(BUILDING_LARGE_MAUSOLEUM);
+    int pantheons = building_count_active(BUILDING_PANTHEON);
     coverage.religion[GOD_CERES] = top(calc_percentage(
         LARARIUM_COVERAGE * larariums +
         ORACLE_COVERAGE * (oracles + small_mausoleums) +
@@ -150,7 +151,7 @@ void city_culture_update_coverage(void)
         SHRINE_COVERAGE * building_count_total(BUILDING_SHRINE_CERES) +
         SMALL_TEMPLE_COVERAGE * building_count_active(BUILDING_SMALL_TEMPLE_CERES) +
         LARGE_TEMPLE_COVERAGE * building_count_active(BUILDING_LARGE_TEMPLE_CERES) +
-        PANTHEON_COVERAGE * building_count_active(BUILDING_PANTHEON) +
+        PANTHEON_COVERAGE * pantheons +
         GRAND_TEMPLE_COVERAGE * building_count_active(BUILDING_GRAND_TEMPLE_CERES),
         population));
     coverage.religion[GOD_NEPTUNE] = top(calc_percentage(
@@ -160,7 +161,7 @@ void city_culture_update_coverage(void)
         SHRINE_COVERAGE * building_count_total(BUILDING_SHRINE_NEPTUNE) +
         SMALL_TEMPLE_COVERAGE * building_count_active(BUILDING_SMALL_TEMPLE_NEPTUNE) +
         LARGE_TEMPLE_COVERAGE * building_count_active(BUILDING_LARGE_TEMPLE_NEPTUNE) +
-        PANTHEON_COVERAGE * building_count_active(BUILDING_PANTHEON) +
+        PANTHEON_COVERAGE * pantheons +
         GRAND_TEMPLE_COVERAGE * building_count_active(BUILDING_GRAND_TEMPLE_NEPTUNE),
         population));
     coverage.religion[GOD_MERCURY] = top(calc_percentage(
@@ -170,7 +171,7 @@ void city_culture_update_coverage(void)
         SHRINE_COVERAGE * building_count_total(BUILDING_SHRINE_MERCURY) +
         SMALL_TEMPLE_COVERAGE * building_count_active(BUILDING_SMALL_TEMPLE_MERCURY) +
         LARGE_TEMPLE_COVERAGE * building_count_active(BUILDING_LARGE_TEMPLE_MERCURY) +
-        PANTHEON_COVERAGE * building_count_active(BUILDING_PANTHEON) +
+        PANTHEON_COVERAGE * pantheons +
         GRAND_TEMPLE_COVERAGE * building_count_active(BUILDING_GRAND_TEMPLE_MERCURY),
         population));
     coverage.religion[GOD_MARS] = top(calc_percentage(
@@ -180,7 +181,7 @@ void city_culture_update_coverage(void)
         SHRINE_COVERAGE * building_count_total(BUILDING_SHRINE_MARS) +
         SMALL_TEMPLE_COVERAGE * building_count_active(BUILDING_SMALL_TEMPLE_MARS) +
         LARGE_TEMPLE_COVERAGE * building_count_active(BUILDING_LARGE_TEMPLE_MARS) +
-        PANTHEON_COVERAGE * building_count_active(BUILDING_PANTHEON) +
+        PANTHEON_COVERAGE * pantheons +
         GRAND_TEMPLE_COVERAGE * building_count_active(BUILDING_GRAND_TEMPLE_MARS),
         population));
     coverage.religion[GOD_VENUS] = top(calc_percentage(
@@ -190,7 +191,7 @@ void city_culture_update_coverage(void)
         SHRINE_COVERAGE * building_count_total(BUILDING_SHRINE_VENUS) +
         SMALL_TEMPLE_COVERAGE * building_count_active(BUILDING_SMALL_TEMPLE_VENUS) +
         LARGE_TEMPLE_COVERAGE * building_count_active(BUILDING_LARGE_TEMPLE_VENUS) +
-        PANTHEON_COVERAGE * building_count_active(BUILDING_PANTHEON) +
+        PANTHEON_COVERAGE * pantheons +
         GRAND_TEMPLE_COVERAGE * building_count_active(BUILDING_GRAND_TEMPLE_VENUS),
         population));
     coverage.oracle = top(calc_percentage(ORACLE_COVERAGE * oracles, population));
@@ -313,24 +313,24 @@ void city_resource_calculate_warehouse_stocks(void)
         }
     }
     for (building *b = building_first_of_type(BUILDING_WAREHOUSE_SPACE); b; b = b->next_of_type) {
-        if (b->state != BUILDING_STATE_IN_USE) {
-            continue;
+        if (b->state == BUILDING_STATE_IN_USE) {
+            building *warehouse = building_main(b);
+            if (warehouse->state == BUILDING_STATE_IN_USE && warehouse->type == BUILDING_WAREHOUSE &&
+                warehouse->has_road_access) {
+                b->has_road_access = warehouse->has_road_access;
+            }
         }
-        building *warehouse = building_main(b);
-        if (warehouse->state != BUILDING_STATE_IN_USE || warehouse->type != BUILDING_WAREHOUSE) {
+    }
+    for (building *b = building_first_of_type(BUILDING_WAREHOUSE); b; b = b->next_of_type) {
+        if (b->state != BUILDING_STATE_IN_USE || !b->has_road_access) {
             continue;
         }
-        if (warehouse->has_road_access) {
-            b->has_road_access = warehouse->has_road_access;
-            if (b->subtype.warehouse_resource_id) {
-                int resource = b->subtype.warehouse_resource_id;
-                int loads = b->resources[resource];
-                city_data.resource.stored_in_warehouses[resource] += loads;
-                city_data.resource.space_in_warehouses[resource] += 4 - loads;
-            } else {
-                city_data.resource.space_in_warehouses[RESOURCE_NONE] += 4;
-            }
+        for (resource_type r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
+            city_data.resource.stored_in_warehouses[r] += building_warehouse_get_amount(b, r);
+            city_data.resource.space_in_warehouses[r] += building_warehouse_get_space_for_resource(b, r);
         }
+        city_data.resource.space_in_warehouses[RESOURCE_NONE] +=
+            building_warehouse_get_space_for_resource(b, RESOURCE_NONE);
     }
 }
 
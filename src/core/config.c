@@ -132,6 +132,11 @@ static const char *ini_keys[] = {
     [CONFIG_GP_CH_HOUSING_DO_NOT_SPAWN_DOGS] = "gameplay_change_houses_do_not_spawn_dogs",
     [CONFIG_UI_SHOW_SHORELINE_DESIRABILITY] = "ui_show_shoreline_desirability",
     [CONFIG_UI_SHOW_ELEVATION_DESIRABILITY] = "ui_show_elevation_desirability",
+    [CONFIG_UI_FULL_CITY_SCREENSHOT_ZOOM] = "ui_full_city_screenshot_zoom",
+    [CONFIG_UI_FULL_CITY_SCREENSHOT_TILED] = "ui_full_city_screenshot_tiled",
+    [CONFIG_GP_DECOUPLED_SIMULATION] = "gameplay_decoupled_simulation",
+    [CONFIG_DEBUG_CHECKPOINT_INTERVAL] = "debug_checkpoint_interval",
+    [CONFIG_DEBUG_CHECKPOINT_COMPARE] = "debug_checkpoint_compare",
 };
 
 static const char *ini_string_keys[] = {
@@ -205,7 +210,12 @@ static int default_values[CONFIG_MAX_ENTRIES] = {
     [CONFIG_UI_WT_PREVIEW_HEAVY_RAIN] = 0,
     [CONFIG_UI_WT_SANDSTORM_SIZE] = 0,
     [CONFIG_UI_WT_SNOWFLAKE_SIZE] = 2,
-    [CONFIG_UI_WT_WEATHER_DURATION] = 1
+    [CONFIG_UI_WT_WEATHER_DURATION] = 1,
+    [CONFIG_UI_FULL_CITY_SCREENSHOT_ZOOM] = 100,
+    [CONFIG_UI_FULL_CITY_SCREENSHOT_TILED] = 0,
+    [CONFIG_GP_DECOUPLED_SIMULATION] = 0,
+    [CONFIG_DEBUG_CHECKPOINT_INTERVAL] = 0,
+    [CONFIG_DEBUG_CHECKPOINT_COMPARE] = 0
 };
 
 static const char default_string_values[CONFIG_STRING_MAX_ENTRIES][CONFIG_STRING_VALUE_MAX] = { 0 };
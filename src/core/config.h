@@ -122,6 +122,11 @@ typedef enum {
     CONFIG_GP_CH_HOUSING_DO_NOT_SPAWN_DOGS,
     CONFIG_UI_SHOW_SHORELINE_DESIRABILITY,
     CONFIG_UI_SHOW_ELEVATION_DESIRABILITY,
+    CONFIG_UI_FULL_CITY_SCREENSHOT_ZOOM,
+    CONFIG_UI_FULL_CITY_SCREENSHOT_TILED,
+    CONFIG_GP_DECOUPLED_SIMULATION,
+    CONFIG_DEBUG_CHECKPOINT_INTERVAL,
+    CONFIG_DEBUG_CHECKPOINT_COMPARE,
     CONFIG_MAX_ENTRIES
 } config_key;
 
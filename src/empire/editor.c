@@ -312,6 +312,7 @@ static int place_object(int mouse_x, int mouse_y)
 
     full->obj.x = x;
     full->obj.y = y;
+    empire_object_positions_changed();
 
     if (full->city_type == EMPIRE_CITY_TRADE || full->city_type == EMPIRE_CITY_FUTURE_TRADE || is_trade_waypoint) {
         window_empire_collect_trade_edges();
@@ -624,6 +625,7 @@ void empire_editor_move_object_end(int mouse_x, int mouse_y)
     }
     obj->x = editor_empire_mouse_to_empire_x(mouse_x) - ((width / 2) * !is_edge);
     obj->y = editor_empire_mouse_to_empire_y(mouse_y) - ((height / 2) * !is_edge);
+    empire_object_positions_changed();
     data.move_id = 0;
     window_empire_collect_trade_edges();
     empire_object_set_trade_route_coords(empire_object_get_our_city());
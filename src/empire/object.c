@@ -22,7 +22,26 @@
 #define EMPIRE_OBJECT_SIZE_STEP 200
 #define LEGACY_EMPIRE_OBJECTS 200
 
+#define INDEX_MIN_CELL_SIZE 32
+#define INDEX_MAX_CELLS_PER_AXIS 256
+
 static array(full_empire_object) objects;
+
+// Uniform grid over the bounding boxes of the objects, rebuilt on the next lookup after objects change
+static struct {
+    int is_valid;
+    int is_expanded;
+    int x_min;
+    int y_min;
+    int cell_size;
+    int cells_x;
+    int cells_y;
+    int *cell_start; // index in ids of the first object of each cell, with an extra end marker
+    int *ids; // object ids per cell, in id order
+} spatial_index;
+
+static unsigned int objects_version;
+
 empire_city_icon_type empire_object_get_random_icon_for_empire_object(full_empire_object *full_obj);
 static void fix_image_ids(void)
 {
@@ -58,8 +77,20 @@ static int empire_object_in_use(const full_empire_object *obj)
     return obj->in_use;
 }
 
+void empire_object_positions_changed(void)
+{
+    spatial_index.is_valid = 0;
+    objects_version++;
+}
+
+unsigned int empire_object_version(void)
+{
+    return objects_version;
+}
+
 void empire_object_clear(void)
 {
+    empire_object_positions_changed();
     if (!array_init(objects, EMPIRE_OBJECT_SIZE_STEP, new_empire_object, empire_object_in_use) ||
         !array_next(objects)) { // Discard object 0
         log_error("Unable to allocate enough memory for the empire object array. The game will now crash.", 0, 0);
@@ -110,6 +141,7 @@ static void migrate_orders(empire_object *obj)
 
 void empire_object_load(buffer *buf, int version)
 {
+    empire_object_positions_changed();
     // we're loading a scenario that does not have a custom empire
     if (buf->size == sizeof(int32_t) && buffer_read_i32(buf) == 0) {
         empire_object_clear();
@@ -524,6 +556,7 @@ full_empire_object *empire_object_get_full(int object_id)
 
 full_empire_object *empire_object_get_new(void)
 {
+    empire_object_positions_changed();
     full_empire_object *obj;
     array_new_item_after_index(objects, 1, obj);
     return obj;
@@ -532,6 +565,7 @@ full_empire_object *empire_object_get_new(void)
 void empire_object_remove(int id)
 {
     array_item(objects, id)->in_use = 0;
+    empire_object_positions_changed();
 }
 
 empire_object *empire_object_get(int object_id)
@@ -599,6 +633,7 @@ const empire_object *empire_object_get_border(void)
 
 void empire_object_change_border_width(int width)
 {
+    empire_object_positions_changed();
     full_empire_object *obj;
     array_foreach(objects, obj) {
         if (obj->in_use) {
@@ -707,42 +742,168 @@ int empire_object_get_max_invasion_path(void)
     return max_path;
 }
 
-int empire_object_get_closest(int x, int y)
+static void get_object_bounds(const empire_object *obj, int *obj_x, int *obj_y, int *width, int *height, int *is_edge)
 {
-    int min_dist = 10000;
-    int min_obj_id = 0;
-    int city_is_selected = 0;
+    if (scenario_empire_is_expanded()) {
+        *obj_x = obj->expanded.x;
+        *obj_y = obj->expanded.y;
+    } else {
+        *obj_x = obj->x;
+        *obj_y = obj->y;
+    }
+    *is_edge = obj->type == EMPIRE_OBJECT_TRADE_WAYPOINT || obj->type == EMPIRE_OBJECT_BORDER_EDGE;
+    if (obj->height) {
+        *width = obj->width;
+        *height = obj->height;
+    } else if (*is_edge) {
+        *width = 19;
+        *height = 18;
+    } else {
+        const image *img = image_get(obj->image_id);
+        *width = img->width;
+        *height = img->height;
+    }
+}
+
+static void get_object_box(const empire_object *obj, int *x_min, int *y_min, int *x_max, int *y_max)
+{
+    int obj_x, obj_y, width, height, is_edge;
+    get_object_bounds(obj, &obj_x, &obj_y, &width, &height, &is_edge);
+    *x_min = obj_x - (is_edge * width / 2);
+    *y_min = obj_y - (is_edge * height / 2);
+    *x_max = obj_x + width + is_edge;
+    *y_max = obj_y + height + is_edge;
+}
+
+static int get_cell_x(int x)
+{
+    return calc_bound((x - spatial_index.x_min) / spatial_index.cell_size, 0, spatial_index.cells_x - 1);
+}
+
+static int get_cell_y(int y)
+{
+    return calc_bound((y - spatial_index.y_min) / spatial_index.cell_size, 0, spatial_index.cells_y - 1);
+}
+
+static int fill_spatial_index(int count_only)
+{
+    int total = 0;
     full_empire_object *full;
     array_foreach(objects, full) {
         if (!full->in_use) {
             continue;
         }
-        const empire_object *obj = &full->obj;
-        int obj_x, obj_y, width, height;
+        int x_min, y_min, x_max, y_max;
+        get_object_box(&full->obj, &x_min, &y_min, &x_max, &y_max);
+        int cell_x_max = get_cell_x(x_max);
+        int cell_y_max = get_cell_y(y_max);
+        for (int cell_y = get_cell_y(y_min); cell_y <= cell_y_max; cell_y++) {
+            for (int cell_x = get_cell_x(x_min); cell_x <= cell_x_max; cell_x++) {
+                int cell = cell_y * spatial_index.cells_x + cell_x;
+                if (count_only) {
+                    spatial_index.cell_start[cell + 1]++;
+                } else {
+                    spatial_index.ids[spatial_index.cell_start[cell]++] = full->obj.id;
+                }
+                total++;
+            }
+        }
+    }
+    return total;
+}
+
+static int build_spatial_index(void)
+{
+    free(spatial_index.cell_start);
+    free(spatial_index.ids);
+    memset(&spatial_index, 0, sizeof(spatial_index));
+
+    int has_objects = 0;
+    int x_min = 0, y_min = 0, x_max = 0, y_max = 0;
+    full_empire_object *full;
+    array_foreach(objects, full) {
+        if (!full->in_use) {
+            continue;
+        }
+        int obj_x_min, obj_y_min, obj_x_max, obj_y_max;
+        get_object_box(&full->obj, &obj_x_min, &obj_y_min, &obj_x_max, &obj_y_max);
+        if (!has_objects || obj_x_min < x_min) {
+            x_min = obj_x_min;
+        }
+        if (!has_objects || obj_y_min < y_min) {
+            y_min = obj_y_min;
+        }
+        if (!has_objects || obj_x_max > x_max) {
+            x_max = obj_x_max;
+        }
+        if (!has_objects || obj_y_max > y_max) {
+            y_max = obj_y_max;
+        }
+        has_objects = 1;
+    }
+    int range = x_max - x_min > y_max - y_min ? x_max - x_min : y_max - y_min;
+    spatial_index.cell_size = range / INDEX_MAX_CELLS_PER_AXIS + 1;
+    if (spatial_index.cell_size < INDEX_MIN_CELL_SIZE) {
+        spatial_index.cell_size = INDEX_MIN_CELL_SIZE;
+    }
+    spatial_index.x_min = x_min;
+    spatial_index.y_min = y_min;
+    spatial_index.cells_x = (x_max - x_min) / spatial_index.cell_size + 1;
+    spatial_index.cells_y = (y_max - y_min) / spatial_index.cell_size + 1;
+    int num_cells = spatial_index.cells_x * spatial_index.cells_y;
+
+    spatial_index.cell_start = calloc(num_cells + 1, sizeof(int));
+    if (!spatial_index.cell_start) {
+        return 0;
+    }
+    int total = fill_spatial_index(1);
+    spatial_index.ids = malloc((total ? total : 1) * sizeof(int));
+    if (!spatial_index.ids) {
+        free(spatial_index.cell_start);
+        spatial_index.cell_start = 0;
+        return 0;
+    }
+    for (int i = 0; i < num_cells; i++) {
+        spatial_index.cell_start[i + 1] += spatial_index.cell_start[i];
+    }
+    // Filling advances each cell start to the start of the next cell, shift them back afterwards
+    fill_spatial_index(0);
+    for (int i = num_cells; i > 0; i--) {
+        spatial_index.cell_start[i] = spatial_index.cell_start[i - 1];
+    }
+    spatial_index.cell_start[0] = 0;
+
+    spatial_index.is_expanded = scenario_empire_is_expanded();
+    spatial_index.is_valid = 1;
+    return 1;
+}
+
+static int ensure_spatial_index(void)
+{
+    if (spatial_index.is_valid && spatial_index.is_expanded == scenario_empire_is_expanded()) {
+        return 1;
+    }
+    return build_spatial_index();
+}
+
+int empire_object_get_closest(int x, int y)
+{
+    if (!ensure_spatial_index()) {
+        return 0;
+    }
+    int min_dist = 10000;
+    int min_obj_id = 0;
+    int city_is_selected = 0;
+    int cell = get_cell_y(y) * spatial_index.cells_x + get_cell_x(x);
+    for (int i = spatial_index.cell_start[cell]; i < spatial_index.cell_start[cell + 1]; i++) {
+        const empire_object *obj = &array_item(objects, spatial_index.ids[i])->obj;
+        int obj_x, obj_y, width, height, is_edge;
         if (city_is_selected && obj->type != EMPIRE_OBJECT_CITY) {
             //Prioritize selecting cities if available
             continue;
         }
-        if (scenario_empire_is_expanded()) {
-            obj_x = obj->expanded.x;
-            obj_y = obj->expanded.y;
-        } else {
-            obj_x = obj->x;
-            obj_y = obj->y;
-        }
-        int is_edge = obj->type == EMPIRE_OBJECT_TRADE_WAYPOINT || obj->type == EMPIRE_OBJECT_BORDER_EDGE;
-        if (obj->height) {
-            width = obj->width;
-            height = obj->height;
-        } else if (is_edge) {
-            width = 19;
-            height = 18;
-        } else {
-            const image *img = image_get(obj->image_id);
-            width = img->width;
-            height = img->height;
-        }
-        
+        get_object_bounds(obj, &obj_x, &obj_y, &width, &height, &is_edge);
+
         if (obj_x - (is_edge * width / 2) > x || obj_x + width / 1 + is_edge <= x) {
             continue;
         }
@@ -757,7 +918,7 @@ int empire_object_get_closest(int x, int y)
                 city_is_selected = 1;
             }
             min_dist = dist;
-            min_obj_id = array_index + 1;
+            min_obj_id = obj->id + 1;
         }
     }
     return min_obj_id;
@@ -765,36 +926,18 @@ int empire_object_get_closest(int x, int y)
 
 int empire_object_get_at(int x, int y)
 {
-    full_empire_object *full;
-    array_foreach(objects, full) {
-        if (!full->in_use) {
-            continue;
-        }
-        const empire_object *obj = &full->obj;
+    if (!ensure_spatial_index()) {
+        return 0;
+    }
+    int cell = get_cell_y(y) * spatial_index.cells_x + get_cell_x(x);
+    for (int i = spatial_index.cell_start[cell]; i < spatial_index.cell_start[cell + 1]; i++) {
+        const empire_object *obj = &array_item(objects, spatial_index.ids[i])->obj;
         if (obj->type == EMPIRE_OBJECT_BORDER || obj->type == EMPIRE_OBJECT_LAND_TRADE_ROUTE
             || obj->type == EMPIRE_OBJECT_SEA_TRADE_ROUTE) {
             continue;
         }
-        int obj_x, obj_y, width, height;
-        if (scenario_empire_is_expanded()) {
-            obj_x = obj->expanded.x;
-            obj_y = obj->expanded.y;
-        } else {
-            obj_x = obj->x;
-            obj_y = obj->y;
-        }
-        int is_edge = obj->type == EMPIRE_OBJECT_TRADE_WAYPOINT || obj->type == EMPIRE_OBJECT_BORDER_EDGE;
-        if (obj->height) {
-            width = obj->width;
-            height = obj->height;
-        } else if (is_edge) {
-            width = 19;
-            height = 18;
-        } else {
-            const image *img = image_get(obj->image_id);
-            width = img->width;
-            height = img->height;
-        }
+        int obj_x, obj_y, width, height, is_edge;
+        get_object_bounds(obj, &obj_x, &obj_y, &width, &height, &is_edge);
         if ((x >= obj_x - (width / 2 * is_edge) && x <= obj_x + width / 1 + is_edge) &&
             (y >= obj_y - (height / 2 * is_edge) && y <= obj_y + height / 1 + is_edge)) {
             return obj->id;
@@ -805,32 +948,50 @@ int empire_object_get_at(int x, int y)
 
 int empire_object_get_nearest_of_type_with_condition(int x, int y, empire_object_type type, int (*condition)(const empire_object *))
 {
+    if (!ensure_spatial_index()) {
+        return 0;
+    }
     int min_dist = 9999;
     int min_id = 0;
-    full_empire_object *full;
-    array_foreach(objects, full) {
-        if (!full->in_use) {
-            continue;
-        }
-        const empire_object *obj = &full->obj;
-        if (obj->type != type) {
-            continue;
-        }
-        if (!condition(obj)) {
-            continue;
-        }
-        int obj_x, obj_y;
-        if (scenario_empire_is_expanded()) {
-            obj_x = obj->expanded.x;
-            obj_y = obj->expanded.y;
-        } else {
-            obj_x = obj->x;
-            obj_y = obj->y;
-        }
-        int dist = calc_euclidean_distance(obj_x, obj_y, x, y);
-        if (dist < min_dist) {
-            min_dist = dist;
-            min_id = obj->id;
+    int center_x = get_cell_x(x);
+    int center_y = get_cell_y(y);
+    int max_ring = spatial_index.cells_x > spatial_index.cells_y ? spatial_index.cells_x : spatial_index.cells_y;
+    // Objects are listed in every cell their box covers, which includes the cell of their position.
+    // Positions in ring r are at least r - 1 cells away from the point, so the search can stop once
+    // the closest object found is nearer than that.
+    for (int ring = 0; ring < max_ring && (!min_id || min_dist >= (ring - 1) * spatial_index.cell_size); ring++) {
+        for (int cell_y = center_y - ring; cell_y <= center_y + ring; cell_y++) {
+            if (cell_y < 0 || cell_y >= spatial_index.cells_y) {
+                continue;
+            }
+            int on_edge = cell_y == center_y - ring || cell_y == center_y + ring;
+            int step = on_edge || ring == 0 ? 1 : 2 * ring;
+            for (int cell_x = center_x - ring; cell_x <= center_x + ring; cell_x += step) {
+                if (cell_x < 0 || cell_x >= spatial_index.cells_x) {
+                    continue;
+                }
+                int cell = cell_y * spatial_index.cells_x + cell_x;
+                for (int i = spatial_index.cell_start[cell]; i < spatial_index.cell_start[cell + 1]; i++) {
+                    const empire_object *obj = &array_item(objects, spatial_index.ids[i])->obj;
+                    if (obj->type != type) {
+                        continue;
+                    }
+                    int obj_x, obj_y;
+                    if (scenario_empire_is_expanded()) {
+                        obj_x = obj->expanded.x;
+                        obj_y = obj->expanded.y;
+                    } else {
+                        obj_x = obj->x;
+                        obj_y = obj->y;
+                    }
+                    int dist = calc_euclidean_distance(obj_x, obj_y, x, y);
+                    // Ties go to the lowest id, as in a scan of all objects
+                    if ((dist < min_dist || (dist == min_dist && obj->id < min_id)) && condition(obj)) {
+                        min_dist = dist;
+                        min_id = obj->id;
+                    }
+                }
+            }
         }
     }
     if (min_dist != 9999 && min_id) {
@@ -902,6 +1063,7 @@ int empire_object_add_ornament(int ornament_id)
     const image *img = image_get(assets_lookup_image_id(ASSET_FIRST_ORNAMENT) - 1 - image_id);
     obj->obj.width = img->width;
     obj->obj.height = img->height;
+    empire_object_positions_changed();
     return 1;
 }
 
@@ -909,6 +1071,7 @@ void empire_object_set_expanded(int object_id, int new_city_type)
 {
     full_empire_object *obj = array_item(objects, object_id);
     obj->city_type = new_city_type;
+    empire_object_positions_changed();
     if (new_city_type == EMPIRE_CITY_TRADE) {
         obj->obj.expanded.image_id = image_group(GROUP_EMPIRE_CITY_TRADE);
     } else if (new_city_type == EMPIRE_CITY_DISTANT_ROMAN) {
@@ -957,6 +1120,7 @@ int empire_object_is_sea_trade_route(int route_id)
 
 void empire_object_set_trade_route_coords(const empire_object *our_city)
 {
+    empire_object_positions_changed();
     int *section_distances = 0;
     for (int i = 0; i < empire_object_count(); i++) {
         full_empire_object *trade_city = empire_object_get_full(i);
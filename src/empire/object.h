@@ -135,6 +135,17 @@ void empire_object_foreach_of_type(void (*callback)(const empire_object *), empi
 
 int empire_object_get_max_invasion_path(void);
 
+/**
+ * Marks the position, size or number of empire objects as changed, so that lookups by position are updated
+ */
+void empire_object_positions_changed(void);
+
+/**
+ * Gets a number that changes every time the empire objects are marked as changed
+ * @return The current version of the empire objects
+ */
+unsigned int empire_object_version(void);
+
 int empire_object_get_closest(int x, int y);
 
 int empire_object_get_at(int x, int y);
@@ -12,6 +12,20 @@
 #include "map/figure.h"
 #include "sound/effect.h"
 
+static const figure_type SOLDIER_TARGET_TYPES[] = {
+    FIGURE_RIOTER, FIGURE_INDIGENOUS_NATIVE,
+    FIGURE_ENEMY43_SPEAR, FIGURE_ENEMY44_SWORD, FIGURE_ENEMY45_SWORD, FIGURE_ENEMY46_CAMEL,
+    FIGURE_ENEMY47_ELEPHANT, FIGURE_ENEMY48_CHARIOT, FIGURE_ENEMY49_FAST_SWORD, FIGURE_ENEMY50_SWORD,
+    FIGURE_ENEMY51_SPEAR, FIGURE_ENEMY52_MOUNTED_ARCHER, FIGURE_ENEMY53_AXE, FIGURE_ENEMY54_GLADIATOR,
+    FIGURE_ENEMY_CAESAR_JAVELIN, FIGURE_ENEMY_CAESAR_MOUNTED, FIGURE_ENEMY_CAESAR_LEGIONARY, FIGURE_ENEMY_CATAPULT
+};
+#define NUM_SOLDIER_TARGET_TYPES (sizeof(SOLDIER_TARGET_TYPES) / sizeof(figure_type))
+
+static const figure_type LEGION_TYPES[] = {
+    FIGURE_FORT_JAVELIN, FIGURE_FORT_MOUNTED, FIGURE_FORT_LEGIONARY, FIGURE_FORT_INFANTRY, FIGURE_FORT_ARCHER
+};
+#define NUM_LEGION_TYPES (sizeof(LEGION_TYPES) / sizeof(figure_type))
+
 static int is_attacking_native(const figure *f)
 {
     return f->type == FIGURE_INDIGENOUS_NATIVE && f->action_state == FIGURE_ACTION_159_NATIVE_ATTACKING;
@@ -177,23 +191,33 @@ void figure_combat_handle_attack(figure *f)
 
 int figure_combat_get_target_for_soldier(int x, int y, int max_distance)
 {
-    int min_figure_id = 0;
+    // Candidates are visited per type, so ties are broken on the lowest id to match a scan over all figures
+    unsigned int min_figure_id = 0;
     int min_distance = 10000;
-    for (unsigned int i = 1; i < figure_count(); i++) {
-        figure *f = figure_get(i);
-        if (figure_is_dead(f) || f->is_ghost) {
-            // Do not allow to target dead and enemies located outside of the map
-            continue;
-        }
-        if (figure_is_enemy(f) || f->type == FIGURE_RIOTER || is_attacking_native(f)) {
+    unsigned int first_figure_id = 0;
+    for (unsigned int t = 0; t < NUM_SOLDIER_TARGET_TYPES; t++) {
+        for (figure *f = figure_first_of_type(SOLDIER_TARGET_TYPES[t]); f; f = f->next_of_type) {
+            if (figure_is_dead(f)) {
+                continue;
+            }
+            if (f->type == FIGURE_INDIGENOUS_NATIVE && !is_attacking_native(f)) {
+                continue;
+            }
+            if (!first_figure_id || f->id < first_figure_id) {
+                first_figure_id = f->id;
+            }
+            if (f->is_ghost) {
+                // Do not allow to target enemies located outside of the map
+                continue;
+            }
             int distance = calc_maximum_distance(x, y, f->x, f->y);
             if (distance <= max_distance) {
                 if (f->targeted_by_figure_id) {
                     distance *= 2; // penalty
                 }
-                if (distance < min_distance) {
+                if (distance < min_distance || (distance == min_distance && f->id < min_figure_id)) {
                     min_distance = distance;
-                    min_figure_id = i;
+                    min_figure_id = f->id;
                 }
             }
         }
@@ -201,16 +225,7 @@ int figure_combat_get_target_for_soldier(int x, int y, int max_distance)
     if (min_figure_id) {
         return min_figure_id;
     }
-    for (unsigned int i = 1; i < figure_count(); i++) {
-        figure *f = figure_get(i);
-        if (figure_is_dead(f)) {
-            continue;
-        }
-        if (figure_is_enemy(f) || f->type == FIGURE_RIOTER || is_attacking_native(f)) {
-            return i;
-        }
-    }
-    return 0;
+    return first_figure_id;
 }
 
 int figure_combat_get_target_for_wolf(int x, int y, int max_distance)
@@ -267,18 +282,23 @@ int figure_combat_get_target_for_wolf(int x, int y, int max_distance)
 
 int figure_combat_get_target_for_enemy(int x, int y)
 {
-    int min_figure_id = 0;
+    unsigned int min_figure_id = 0;
     int min_distance = 10000;
-    for (unsigned int i = 1; i < figure_count(); i++) {
-        figure *f = figure_get(i);
-        if (figure_is_dead(f)) {
-            continue;
-        }
-        if (!f->targeted_by_figure_id && figure_is_legion(f)) {
-            int distance = calc_maximum_distance(x, y, f->x, f->y);
-            if (distance < min_distance) {
-                min_distance = distance;
-                min_figure_id = i;
+    unsigned int first_figure_id = 0;
+    for (unsigned int t = 0; t < NUM_LEGION_TYPES; t++) {
+        for (figure *f = figure_first_of_type(LEGION_TYPES[t]); f; f = f->next_of_type) {
+            if (figure_is_dead(f)) {
+                continue;
+            }
+            if (!first_figure_id || f->id < first_figure_id) {
+                first_figure_id = f->id;
+            }
+            if (!f->targeted_by_figure_id) {
+                int distance = calc_maximum_distance(x, y, f->x, f->y);
+                if (distance < min_distance || (distance == min_distance && f->id < min_figure_id)) {
+                    min_distance = distance;
+                    min_figure_id = f->id;
+                }
             }
         }
     }
@@ -286,16 +306,7 @@ int figure_combat_get_target_for_enemy(int x, int y)
         return min_figure_id;
     }
     // no 'free' soldier found, take first one
-    for (unsigned int i = 1; i < figure_count(); i++) {
-        figure *f = figure_get(i);
-        if (figure_is_dead(f)) {
-            continue;
-        }
-        if (figure_is_legion(f)) {
-            return i;
-        }
-    }
-    return 0;
+    return first_figure_id;
 }
 
 static int is_valid_missile_target(figure *f, formation *l)
@@ -18,6 +18,8 @@
 #include "map/grid.h"
 #include "figure.h"
 
+#include <string.h>
+
 #define FIGURE_ARRAY_SIZE_STEP 1000
 
 #define FIGURE_ORIGINAL_BUFFER_SIZE 128
@@ -26,6 +28,8 @@
 static struct {
     int created_sequence;
     array(figure) figures;
+    figure *first_of_type[FIGURE_TYPE_MAX];
+    figure *last_of_type[FIGURE_TYPE_MAX];
 } data;
 
 figure *figure_get(unsigned int id)
@@ -38,6 +42,81 @@ unsigned int figure_count(void)
     return data.figures.size;
 }
 
+figure *figure_first_of_type(figure_type type)
+{
+    return data.first_of_type[type];
+}
+
+static void add_to_type_list(figure *f)
+{
+    figure *first = data.first_of_type[f->type];
+    figure *last = data.last_of_type[f->type];
+    if (!first || !last) {
+        f->prev_of_type = 0;
+        f->next_of_type = 0;
+        data.first_of_type[f->type] = f;
+        data.last_of_type[f->type] = f;
+    } else if (f->id < first->id) {
+        first->prev_of_type = f;
+        f->next_of_type = first;
+        f->prev_of_type = 0;
+        data.first_of_type[f->type] = f;
+    } else if (f->id > last->id) {
+        last->next_of_type = f;
+        f->prev_of_type = last;
+        f->next_of_type = 0;
+        data.last_of_type[f->type] = f;
+    } else if (f != first && f != last) {
+        unsigned int id = f->id - 1;
+        while (id) {
+            figure *prev = figure_get(id);
+            if (prev->state && prev->type == f->type) {
+                f->prev_of_type = prev;
+                f->next_of_type = prev->next_of_type;
+                f->next_of_type->prev_of_type = f;
+                prev->next_of_type = f;
+                break;
+            }
+            id--;
+        }
+    }
+}
+
+static void remove_from_type_list(figure *f)
+{
+    figure *first = data.first_of_type[f->type];
+    figure *last = data.last_of_type[f->type];
+    if (f == first && f == last) {
+        data.first_of_type[f->type] = 0;
+        data.last_of_type[f->type] = 0;
+    } else if (f == first) {
+        data.first_of_type[f->type] = f->next_of_type;
+        if (f->next_of_type) {
+            f->next_of_type->prev_of_type = 0;
+        }
+    } else if (f == last) {
+        data.last_of_type[f->type] = f->prev_of_type;
+        if (f->prev_of_type) {
+            f->prev_of_type->next_of_type = 0;
+        }
+    } else if (f->prev_of_type && f->next_of_type) {
+        f->prev_of_type->next_of_type = f->next_of_type;
+        f->next_of_type->prev_of_type = f->prev_of_type;
+    }
+    f->prev_of_type = 0;
+    f->next_of_type = 0;
+}
+
+void figure_change_type(figure *f, figure_type type)
+{
+    if (f->type == type) {
+        return;
+    }
+    remove_from_type_list(f);
+    f->type = type;
+    add_to_type_list(f);
+}
+
 figure *figure_create(figure_type type, int x, int y, direction_type dir)
 {
     figure *f = 0;
@@ -68,6 +147,7 @@ figure *figure_create(figure_type type, int x, int y, direction_type dir)
     random_generate_next();
     f->name = figure_name_get(type, 0);
     f->phrase_sequence_city = f->phrase_sequence_exact = random_byte() & 3;
+    add_to_type_list(f);
     map_figure_add(f);
     if (type == FIGURE_TRADE_CARAVAN || type == FIGURE_TRADE_SHIP || type == FIGURE_NATIVE_TRADER) {
         f->trader_id = trader_create();
@@ -204,6 +284,7 @@ void figure_delete(figure *f)
     figure_visited_buildings_remove_list(f->last_visited_index);
     figure_route_remove(f);
     map_figure_delete(f);
+    remove_from_type_list(f);
 
     int figure_id = f->id;
     memset(f, 0, sizeof(figure));
@@ -287,6 +368,25 @@ int figure_enemy_class(const figure *f)
     }
 }
 
+int figure_count_enemies(enemy_class_t enemy_class)
+{
+    int count = 0;
+    for (figure_type type = FIGURE_ENEMY43_SPEAR; type <= FIGURE_ENEMY_CATAPULT; type++) {
+        if (type > FIGURE_ENEMY_CAESAR_LEGIONARY && type != FIGURE_ENEMY_CATAPULT) {
+            continue;
+        }
+        for (const figure *f = data.first_of_type[type]; f; f = f->next_of_type) {
+            if (figure_is_dead(f)) {
+                continue;
+            }
+            if (enemy_class == ENEMY_CLASS_ALL || figure_enemy_class(f) == (int) enemy_class) {
+                count++;
+            }
+        }
+    }
+    return count;
+}
+
 int figure_is_legion(const figure *f)
 {
     return (f->type >= FIGURE_FORT_JAVELIN && f->type <= FIGURE_FORT_LEGIONARY) || f->type == FIGURE_FORT_INFANTRY || f->type == FIGURE_FORT_ARCHER;
@@ -320,6 +420,8 @@ void figure_init_scenario(void)
         log_error("Unable to create figures array. The game will now crash.", 0, 0);
     }
     data.created_sequence = 0;
+    memset(data.first_of_type, 0, sizeof(data.first_of_type));
+    memset(data.last_of_type, 0, sizeof(data.last_of_type));
 }
 
 void figure_kill_all(void)
@@ -661,4 +763,14 @@ void figure_load_state(buffer *list, buffer *seq, int version)
         }
     }
     data.figures.size = highest_id_in_use + 1;
+
+    memset(data.first_of_type, 0, sizeof(data.first_of_type));
+    memset(data.last_of_type, 0, sizeof(data.last_of_type));
+    figure *f;
+    array_foreach(data.figures, f)
+    {
+        if (f->state) {
+            add_to_type_list(f);
+        }
+    }
 }
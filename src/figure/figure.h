@@ -9,9 +9,45 @@
 
 #define FIGURE_FACTION_ROAMER_PREVIEW 2
 
-typedef struct {
+typedef struct figure {
+    // Fields read by the per-tick action and movement loops come first,
+    // so iterating over figures touches as few cache lines as possible
     unsigned int id;
+    unsigned char state;
+    unsigned char type;
+    unsigned char action_state;
+    unsigned char faction_id; // 2 = roamer preview, 1 = city, 0 = enemy
+    unsigned char x;
+    unsigned char y;
+    unsigned char previous_tile_x;
+    unsigned char previous_tile_y;
+    short grid_offset;
+    unsigned char progress_on_tile;
+    signed char direction;
+    signed char previous_tile_direction;
+    unsigned char is_ghost;
+    unsigned char terrain_usage;
+    unsigned char is_boat; // 1 for boat, 2 for flotsam
+    unsigned char destination_x;
+    unsigned char destination_y;
+    short wait_ticks;
+    unsigned short targeted_by_figure_id;
+    unsigned short target_figure_id;
+    unsigned int routing_path_id;
+    unsigned int routing_path_current_tile;
+    unsigned int routing_path_length;
+    unsigned char use_cross_country;
+    unsigned char speed_multiplier;
+    unsigned char cc_direction; // 1 = x, 2 = y
+    unsigned char in_building_wait_ticks;
+    short cross_country_x; // position = 15 * x + offset on tile
+    short cross_country_y; // position = 15 * y + offset on tile
+    short next_figure_id_on_same_tile;
+    unsigned char is_on_road;
+    char progress_to_next_tick;
+    unsigned int building_id;
 
+    // Fields only used by some figure types, by the UI or while saving
     unsigned int image_id;
     unsigned int cart_image_id;
     unsigned char image_offset;
@@ -19,26 +55,12 @@ typedef struct {
 
     unsigned char alternative_location_index;
     unsigned char flotsam_visible;
-    short next_figure_id_on_same_tile;
-    unsigned char type;
     unsigned char resource_id;
-    unsigned char use_cross_country;
     unsigned char is_friendly;
-    unsigned char state;
-    unsigned char faction_id; // 2 = roamer preview, 1 = city, 0 = enemy
     unsigned char action_state_before_attack;
-    signed char direction;
-    signed char previous_tile_direction;
     signed char attack_direction;
-    unsigned char x;
-    unsigned char y;
-    unsigned char previous_tile_x;
-    unsigned char previous_tile_y;
     unsigned char missile_height;
     unsigned char damage;
-    short grid_offset;
-    unsigned char destination_x;
-    unsigned char destination_y;
     short destination_grid_offset; // only used for soldiers
     unsigned char source_x;
     unsigned char source_y;
@@ -51,39 +73,24 @@ typedef struct {
         signed char enemy;
     } formation_position_y;
     short disallow_diagonal;
-    short wait_ticks;
-    unsigned char action_state;
-    unsigned char progress_on_tile;
-    unsigned int routing_path_id;
-    unsigned int routing_path_current_tile;
-    unsigned int routing_path_length;
-    unsigned char in_building_wait_ticks;
-    unsigned char is_on_road;
     short max_roam_length;
     short roam_length;
     unsigned char roam_choose_destination;
     unsigned char roam_random_counter;
     signed char roam_turn_direction;
     signed char roam_ticks_until_next_turn;
-    short cross_country_x; // position = 15 * x + offset on tile
-    short cross_country_y; // position = 15 * y + offset on tile
     short cc_destination_x;
     short cc_destination_y;
     short cc_delta_x;
     short cc_delta_y;
     short cc_delta_xy;
-    unsigned char cc_direction; // 1 = x, 2 = y
-    unsigned char speed_multiplier;
-    unsigned int building_id;
     unsigned int immigrant_building_id;
     unsigned int destination_building_id;
     unsigned int formation_id;
     unsigned char index_in_formation;
     unsigned char formation_at_rest;
     unsigned char migrant_num_people;
-    unsigned char is_ghost;
     unsigned char min_max_seen;
-    char progress_to_next_tick;
     short leading_figure_id;
     unsigned char attack_image_offset;
     unsigned char wait_ticks_missile;
@@ -92,9 +99,7 @@ typedef struct {
     unsigned char empire_city_id;
     unsigned char trader_amount_bought;
     short name;
-    unsigned char terrain_usage;
     unsigned char loads_sold_or_carrying;
-    unsigned char is_boat; // 1 for boat, 2 for flotsam
     unsigned char height_adjusted_ticks;
     unsigned char current_height;
     unsigned char target_height;
@@ -106,8 +111,6 @@ typedef struct {
     unsigned char trader_id;
     unsigned char wait_ticks_next_target; //used for retargetting for fighting figures, and destination for pushers
     unsigned char dont_draw_elevated;
-    unsigned short target_figure_id;
-    unsigned short targeted_by_figure_id;
     unsigned short created_sequence;
     unsigned short target_figure_created_sequence;
     unsigned char figures_on_same_tile_index;
@@ -123,6 +126,9 @@ typedef struct {
         unsigned short visited_building_type_ids[12];
         unsigned char tourist_rank;
     } tourist;
+    // Figures of the same type, in id order. Not saved, rebuilt on load
+    struct figure *prev_of_type;
+    struct figure *next_of_type;
 } figure;
 
 figure *figure_get(unsigned int id);
@@ -141,6 +147,21 @@ figure *figure_create(figure_type type, int x, int y, direction_type dir);
 
 void figure_delete(figure *f);
 
+/**
+ * Gets the first existing figure of a type. The others follow through figure->next_of_type.
+ * Dead figures stay in the list until they are deleted.
+ * @param type Figure type
+ * @return The figure with the lowest id of that type, or 0 if there is none
+ */
+figure *figure_first_of_type(figure_type type);
+
+/**
+ * Changes the type of an existing figure, keeping the per-type lists up to date
+ * @param f Figure
+ * @param type New type
+ */
+void figure_change_type(figure *f, figure_type type);
+
 int figure_is_dead(const figure *f);
 
 int figure_is_enemy(const figure *f);
@@ -153,6 +174,13 @@ int figure_is_mounted_enemy(const figure *f);
 
 int figure_is_caesar_enemy(const figure *f);
 
+/**
+ * Counts the enemy figures that are still alive
+ * @param enemy_class Only count enemies of this class, or ENEMY_CLASS_ALL for all of them
+ * @return The number of enemies
+ */
+int figure_count_enemies(enemy_class_t enemy_class);
+
 int figure_is_legion(const figure *f);
 
 int figure_is_herd(const figure *f);
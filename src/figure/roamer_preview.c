@@ -10,17 +10,56 @@
 #include "map/building.h"
 #include "map/grid.h"
 #include "map/road_access.h"
+#include "map/routing_terrain.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #define TOTAL_ROAMERS 4
 #define MAX_STORED_BUILDING_TYPES 2
+#define MAX_CACHED_PREVIEWS 32
 #define SHOWN_BUILDING_OFFSET 12
 
+typedef struct {
+    int grid_offset;
+    uint8_t value;
+} roamer_tile;
+
+typedef struct {
+    building_type type;
+    int grid_offset;
+    int is_stored;
+    int is_shown;
+    unsigned int last_used;
+    int num_tiles;
+    roamer_tile *tiles;
+} roamer_result;
+
+typedef struct {
+    uint16_t passages;
+    uint8_t entries;
+    uint8_t exits;
+    uint8_t entry_exits;
+} tile_frequency;
+
 static struct {
     grid_u8 travelled_tiles;
+    int touched_tiles[GRID_SIZE * GRID_SIZE];
+    int num_touched_tiles;
+    tile_frequency frequency[GRID_SIZE * GRID_SIZE];
+    roamer_result *results;
+    int num_results;
+    int results_capacity;
+    unsigned int use_counter;
+    struct {
+        unsigned int network;
+        int dont_skip_corners;
+        int global_labour;
+        int rotation;
+    } version;
     building_type types[MAX_STORED_BUILDING_TYPES];
     int stored_building_types;
+    int show_stored_building_types;
 } data;
 
 static figure_type building_type_to_figure_type(building_type type)
@@ -199,29 +238,19 @@ static int determine_road_access(int x, int y, int size, building_type type, map
     }
 }
 
-void figure_roamer_preview_create(building_type b_type, int x, int y)
+static void mark_travelled(int grid_offset, int value)
 {
-    if (!config_get(CONFIG_UI_SHOW_ROAMING_PATH)) {
-        figure_roamer_preview_reset_building_types();
-        return;
+    if (!data.travelled_tiles.items[grid_offset]) {
+        data.touched_tiles[data.num_touched_tiles++] = grid_offset;
     }
+    data.travelled_tiles.items[grid_offset] = value;
+}
 
+static void simulate_roamers(building_type b_type, int x, int y)
+{
     figure_type fig_type = building_type_to_figure_type(b_type);
-    if (fig_type == FIGURE_NONE) {
-        return;
-    }
-
-    if (fig_type == FIGURE_LABOR_SEEKER && config_get(CONFIG_GP_CH_GLOBAL_LABOUR)) {
-        return;
-    }
 
-    int grid_offset = map_grid_offset(x, y);
-
-    if (data.travelled_tiles.items[grid_offset] == SHOWN_BUILDING_OFFSET) {
-        return;
-    }
-
-    data.travelled_tiles.items[grid_offset] = SHOWN_BUILDING_OFFSET;
+    mark_travelled(map_grid_offset(x, y), SHOWN_BUILDING_OFFSET);
 
     int b_size = building_is_farm(b_type) ? 3 : building_properties_for_type(b_type)->size;
 
@@ -265,12 +294,12 @@ void figure_roamer_preview_create(building_type b_type, int x, int y)
         }
         roamer.grid_offset = map_grid_offset(roamer.x, roamer.y);
         if (map_grid_is_valid_offset(roamer.grid_offset)) {
-            data.travelled_tiles.items[roamer.grid_offset] = FIGURE_ROAMER_PREVIEW_EXIT_TILE;
+            mark_travelled(roamer.grid_offset, FIGURE_ROAMER_PREVIEW_EXIT_TILE);
         }
         init_roaming(&roamer, i * 2, roamer.x, roamer.y);
         while (++roamer.roam_length < roamer.max_roam_length) {
             if (roamer.progress_on_tile == 0 && data.travelled_tiles.items[roamer.grid_offset] < FIGURE_ROAMER_PREVIEW_MAX_PASSAGES) {
-                data.travelled_tiles.items[roamer.grid_offset]++;
+                mark_travelled(roamer.grid_offset, data.travelled_tiles.items[roamer.grid_offset] + 1);
             }
             figure_movement_roam_ticks(&roamer, 1);
         }
@@ -285,7 +314,7 @@ void figure_roamer_preview_create(building_type b_type, int x, int y)
         while (roamer.direction != DIR_FIGURE_AT_DESTINATION &&
             roamer.direction != DIR_FIGURE_REROUTE && roamer.direction != DIR_FIGURE_LOST) {
             if (data.travelled_tiles.items[roamer.grid_offset] < FIGURE_ROAMER_PREVIEW_MAX_PASSAGES) {
-                data.travelled_tiles.items[roamer.grid_offset]++;
+                mark_travelled(roamer.grid_offset, data.travelled_tiles.items[roamer.grid_offset] + 1);
             }
             roamer.progress_on_tile = 15;
             figure_movement_move_ticks(&roamer, 1);
@@ -293,10 +322,220 @@ void figure_roamer_preview_create(building_type b_type, int x, int y)
         figure_route_remove(&roamer);
         if (roamer.direction == DIR_FIGURE_AT_DESTINATION) {
             int tile_type = data.travelled_tiles.items[roamer.grid_offset];
-            data.travelled_tiles.items[roamer.grid_offset] = tile_type < FIGURE_ROAMER_PREVIEW_EXIT_TILE ?
-                FIGURE_ROAMER_PREVIEW_ENTRY_TILE : FIGURE_ROAMER_PREVIEW_ENTRY_EXIT_TILE;
+            mark_travelled(roamer.grid_offset, tile_type < FIGURE_ROAMER_PREVIEW_EXIT_TILE ?
+                FIGURE_ROAMER_PREVIEW_ENTRY_TILE : FIGURE_ROAMER_PREVIEW_ENTRY_EXIT_TILE);
+        }
+    }
+}
+
+static void update_frequency(const roamer_result *result, int amount)
+{
+    for (int i = 0; i < result->num_tiles; i++) {
+        tile_frequency *frequency = &data.frequency[result->tiles[i].grid_offset];
+        switch (result->tiles[i].value) {
+            case FIGURE_ROAMER_PREVIEW_ENTRY_TILE:
+                frequency->entries += amount;
+                break;
+            case FIGURE_ROAMER_PREVIEW_EXIT_TILE:
+                frequency->exits += amount;
+                break;
+            case FIGURE_ROAMER_PREVIEW_ENTRY_EXIT_TILE:
+                frequency->entry_exits += amount;
+                break;
+            default:
+                frequency->passages += amount * result->tiles[i].value;
+                break;
+        }
+    }
+}
+
+static void show_result(roamer_result *result)
+{
+    if (!result->is_shown) {
+        update_frequency(result, 1);
+        result->is_shown = 1;
+    }
+}
+
+static void hide_result(roamer_result *result)
+{
+    if (result->is_shown) {
+        update_frequency(result, -1);
+        result->is_shown = 0;
+    }
+}
+
+static void clear_results(void)
+{
+    for (int i = 0; i < data.num_results; i++) {
+        free(data.results[i].tiles);
+    }
+    data.num_results = 0;
+    memset(data.frequency, 0, sizeof(data.frequency));
+}
+
+static void remove_result(int index)
+{
+    hide_result(&data.results[index]);
+    free(data.results[index].tiles);
+    data.num_results--;
+    data.results[index] = data.results[data.num_results];
+}
+
+static int evict_unused_preview(void)
+{
+    int oldest = -1;
+    int num_previews = 0;
+    for (int i = 0; i < data.num_results; i++) {
+        const roamer_result *result = &data.results[i];
+        if (result->is_stored) {
+            continue;
+        }
+        num_previews++;
+        if (!result->is_shown && (oldest == -1 || result->last_used < data.results[oldest].last_used)) {
+            oldest = i;
         }
     }
+    if (num_previews < MAX_CACHED_PREVIEWS || oldest == -1) {
+        return 0;
+    }
+    remove_result(oldest);
+    return 1;
+}
+
+static roamer_result *find_result(building_type type, int grid_offset)
+{
+    for (int i = 0; i < data.num_results; i++) {
+        if (data.results[i].type == type && data.results[i].grid_offset == grid_offset) {
+            data.results[i].last_used = ++data.use_counter;
+            return &data.results[i];
+        }
+    }
+    return 0;
+}
+
+static roamer_result *create_result(building_type type, int x, int y)
+{
+    evict_unused_preview();
+    if (data.num_results == data.results_capacity) {
+        int capacity = data.results_capacity ? data.results_capacity * 2 : 64;
+        roamer_result *results = realloc(data.results, capacity * sizeof(roamer_result));
+        if (!results) {
+            return 0;
+        }
+        data.results = results;
+        data.results_capacity = capacity;
+    }
+
+    data.num_touched_tiles = 0;
+    simulate_roamers(type, x, y);
+
+    roamer_result *result = &data.results[data.num_results];
+    memset(result, 0, sizeof(roamer_result));
+    result->type = type;
+    result->grid_offset = map_grid_offset(x, y);
+    result->last_used = ++data.use_counter;
+    result->tiles = malloc(data.num_touched_tiles * sizeof(roamer_tile));
+    for (int i = 0; i < data.num_touched_tiles; i++) {
+        int grid_offset = data.touched_tiles[i];
+        // The building marker only prevents roamers from counting the building tile itself
+        if (result->tiles && data.travelled_tiles.items[grid_offset] != SHOWN_BUILDING_OFFSET) {
+            result->tiles[result->num_tiles].grid_offset = grid_offset;
+            result->tiles[result->num_tiles].value = data.travelled_tiles.items[grid_offset];
+            result->num_tiles++;
+        }
+        data.travelled_tiles.items[grid_offset] = 0;
+    }
+    data.num_results++;
+    return result;
+}
+
+static roamer_result *get_result(building_type type, int x, int y)
+{
+    roamer_result *result = find_result(type, map_grid_offset(x, y));
+    return result ? result : create_result(type, x, y);
+}
+
+static int can_show_roamers(building_type type)
+{
+    figure_type fig_type = building_type_to_figure_type(type);
+    if (fig_type == FIGURE_NONE) {
+        return 0;
+    }
+    return fig_type != FIGURE_LABOR_SEEKER || !config_get(CONFIG_GP_CH_GLOBAL_LABOUR);
+}
+
+static void show_stored_building_type(building_type type)
+{
+    for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
+        if (!can_show_roamers(b->type)) {
+            continue;
+        }
+        roamer_result *result = get_result(b->type, b->x, b->y);
+        if (result) {
+            result->is_stored = 1;
+            show_result(result);
+        }
+    }
+}
+
+static void set_stored_building_types_visible(int visible)
+{
+    if (visible) {
+        if (!data.show_stored_building_types) {
+            for (int i = 0; i < data.stored_building_types; i++) {
+                show_stored_building_type(data.types[i]);
+            }
+        }
+    } else {
+        // Also hides stored buildings that were shown on their own, e.g. when selected
+        for (int i = 0; i < data.num_results; i++) {
+            if (data.results[i].is_stored) {
+                hide_result(&data.results[i]);
+            }
+        }
+    }
+    data.show_stored_building_types = visible;
+}
+
+static void validate_results(void)
+{
+    unsigned int network = map_routing_citizen_network_version();
+    int dont_skip_corners = config_get(CONFIG_GP_CH_ROAMERS_DONT_SKIP_CORNERS);
+    int global_labour = config_get(CONFIG_GP_CH_GLOBAL_LABOUR);
+    int rotation = building_rotation_get_rotation();
+    if (network == data.version.network && dont_skip_corners == data.version.dont_skip_corners &&
+        global_labour == data.version.global_labour && rotation == data.version.rotation) {
+        return;
+    }
+    data.version.network = network;
+    data.version.dont_skip_corners = dont_skip_corners;
+    data.version.global_labour = global_labour;
+    data.version.rotation = rotation;
+
+    // The roads or buildings changed, so every stored roam is stale: simulate the visible ones again
+    clear_results();
+    if (data.show_stored_building_types) {
+        for (int i = 0; i < data.stored_building_types; i++) {
+            show_stored_building_type(data.types[i]);
+        }
+    }
+}
+
+void figure_roamer_preview_create(building_type b_type, int x, int y)
+{
+    if (!config_get(CONFIG_UI_SHOW_ROAMING_PATH)) {
+        figure_roamer_preview_reset_building_types();
+        return;
+    }
+    if (!can_show_roamers(b_type)) {
+        return;
+    }
+    validate_results();
+    roamer_result *result = get_result(b_type, x, y);
+    if (result) {
+        show_result(result);
+    }
 }
 
 void figure_roamer_preview_create_all_for_building_type(building_type type)
@@ -316,16 +555,21 @@ void figure_roamer_preview_create_all_for_building_type(building_type type)
     if (data.stored_building_types == MAX_STORED_BUILDING_TYPES) {
         return;
     }
-    for (building *b = building_first_of_type(type); b; b = b->next_of_type) {
-        figure_roamer_preview_create(type, b->x, b->y);
-    }
+    validate_results();
     data.types[data.stored_building_types] = type;
     data.stored_building_types++;
+    data.show_stored_building_types = 1;
+    show_stored_building_type(type);
 }
 
 void figure_roamer_preview_reset(building_type type)
 {
-    map_grid_clear_u8(data.travelled_tiles.items);
+    validate_results();
+    for (int i = 0; i < data.num_results; i++) {
+        if (!data.results[i].is_stored) {
+            hide_result(&data.results[i]);
+        }
+    }
     int show_other_roamers = 0;
     figure_type fig_type = building_type_to_figure_type(type);
     if (fig_type == FIGURE_LABOR_SEEKER && config_get(CONFIG_GP_CH_GLOBAL_LABOUR)) {
@@ -341,22 +585,29 @@ void figure_roamer_preview_reset(building_type type)
             }
         }
     }
-    if (show_other_roamers) {
-        for (int i = 0; i < data.stored_building_types; i++) {
-            for (building *b = building_first_of_type(data.types[i]); b; b = b->next_of_type) {
-                figure_roamer_preview_create(b->type, b->x, b->y);
-            }
-        }
-    }
+    set_stored_building_types_visible(show_other_roamers);
 }
 
 void figure_roamer_preview_reset_building_types(void)
 {
     data.stored_building_types = 0;
-    figure_roamer_preview_reset(BUILDING_NONE);
+    data.show_stored_building_types = 0;
+    clear_results();
 }
 
 int figure_roamer_preview_get_frequency(int grid_offset)
 {
-    return map_grid_is_valid_offset(grid_offset) ? data.travelled_tiles.items[grid_offset] : 0;
+    if (!map_grid_is_valid_offset(grid_offset)) {
+        return 0;
+    }
+    const tile_frequency *frequency = &data.frequency[grid_offset];
+    if (frequency->entry_exits || (frequency->entries && frequency->exits)) {
+        return FIGURE_ROAMER_PREVIEW_ENTRY_EXIT_TILE;
+    } else if (frequency->exits) {
+        return FIGURE_ROAMER_PREVIEW_EXIT_TILE;
+    } else if (frequency->entries) {
+        return FIGURE_ROAMER_PREVIEW_ENTRY_TILE;
+    }
+    return frequency->passages < FIGURE_ROAMER_PREVIEW_MAX_PASSAGES ?
+        frequency->passages : FIGURE_ROAMER_PREVIEW_MAX_PASSAGES;
 }
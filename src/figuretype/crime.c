@@ -380,7 +380,7 @@ void figure_rioter_action(figure *f)
                     f->destination_building_id = building_id;
                     figure_route_remove(f);
                 } else {
-                    f->type = FIGURE_CRIMINAL;
+                    figure_change_type(f, FIGURE_CRIMINAL);
                     f->action_state = FIGURE_ACTION_120_RIOTER_CREATED;
                     figure_route_remove(f);
                 }
@@ -321,7 +321,7 @@ void figure_entertainer_action(figure *f)
         if (f->action_state == FIGURE_ACTION_92_ENTERTAINER_GOING_TO_VENUE ||
             f->action_state == FIGURE_ACTION_94_ENTERTAINER_ROAMING ||
             f->action_state == FIGURE_ACTION_95_ENTERTAINER_RETURNING) {
-            f->type = FIGURE_ENEMY54_GLADIATOR;
+            figure_change_type(f, FIGURE_ENEMY54_GLADIATOR);
             figure_route_remove(f);
             f->roam_length = 0;
             f->action_state = FIGURE_ACTION_158_NATIVE_CREATED;
@@ -351,6 +351,16 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
     int permissions = f->type == FIGURE_NATIVE_TRADER ? BUILDING_STORAGE_PERMISSION_NATIVES : BUILDING_STORAGE_PERMISSION_TRADERS;
     int sell_capacity = max_trade_units - f->loads_sold_or_carrying;
     int buy_capacity = max_trade_units - f->trader_amount_bought;
+    uint64_t sell_resources = 0;
+    uint64_t buy_resources = 0;
+    for (int r = RESOURCE_MIN; r < RESOURCE_MAX; r++) {
+        if (sellable[r] > 0 && sell_capacity > 0) {
+            sell_resources |= BUILDING_STORAGE_RESOURCE_FLAG(r);
+        }
+        if (buyable[r] > 0 && buy_capacity > 0) {
+            buy_resources |= BUILDING_STORAGE_RESOURCE_FLAG(r);
+        }
+    }
     int best_score = -1;
     int building_types[] = { BUILDING_GRANARY, BUILDING_WAREHOUSE };
     int best_building_id = 0;
@@ -363,6 +373,12 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
             !building_storage_get_permission(permissions, b)) {
                 continue; // Not active, infected, unreachable by road, recently visited, currenty at, not accepted
             }
+            // Storages without room for anything to sell or stock of anything to buy can't score
+            uint64_t can_sell = building_storage_resources_with_room(b) & sell_resources;
+            uint64_t can_buy = building_storage_resources_in_stock(b) & buy_resources;
+            if (!can_sell && !can_buy) {
+                continue;
+            }
 
             int sell_score = 0; // Score for how many units the trader can sell to this building
             int buy_score = 0;  // Score for how many units the trader can buy from this building
@@ -372,7 +388,7 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
                     continue;
                 }
                 // === SELL SCORING: Trader -> Building ===
-                if (sellable[r] > 0 && sell_capacity > 0) {
+                if (can_sell & BUILDING_STORAGE_RESOURCE_FLAG(r)) {
                     // Get how much of this resource the building can accept
                     int receptable = (building_types[t] == BUILDING_GRANARY)
                         ? building_granary_maximum_receptible_amount(b, r) :
@@ -384,7 +400,7 @@ static int get_closest_storage(const figure *f, int x, int y, int city_id, map_p
                 }
 
                 // === BUY SCORING: Building -> Trader ===
-                if (buyable[r] > 0 && buy_capacity > 0) {
+                if (can_buy & BUILDING_STORAGE_RESOURCE_FLAG(r)) {
                     // Get how much of this resource the building currently holds
                     int available = (building_types[t] == BUILDING_GRANARY)
                         ? building_granary_get_amount(b, r) : building_warehouse_get_available_amount(b, r);
@@ -327,7 +327,7 @@ void figure_sink_all_ships(void)
             continue;
         }
         f->building_id = 0;
-        f->type = FIGURE_SHIPWRECK;
+        figure_change_type(f, FIGURE_SHIPWRECK);
         f->wait_ticks = 0;
     }
 }
@@ -364,7 +364,7 @@ void figure_sink_half_ships(void)
             continue;
         }
         f->building_id = 0;
-        f->type = FIGURE_SHIPWRECK;
+        figure_change_type(f, FIGURE_SHIPWRECK);
         f->wait_ticks = 0;
     }
 }
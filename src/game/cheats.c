@@ -32,6 +32,7 @@
 #include "window/console.h"
 #include "window/editor/attributes.h"
 #include "window/editor/scenario_events.h"
+#include "window/fast_forward.h"
 #include "window/plain_message_dialog.h"
 
 #include <string.h>
@@ -56,6 +57,7 @@ static void game_cheat_disable_legions_consumption(uint8_t *);
 static void game_cheat_disable_invasions(uint8_t *);
 static void game_cheat_change_weather(uint8_t *);
 static void game_cheat_destroy_building(uint8_t *);
+static void game_cheat_fast_forward(uint8_t *);
 
 static void (*const execute_command[])(uint8_t *args) = {
     game_cheat_add_money,
@@ -77,7 +79,8 @@ static void (*const execute_command[])(uint8_t *args) = {
     game_cheat_disable_legions_consumption,
     game_cheat_disable_invasions,
     game_cheat_change_weather,
-    game_cheat_destroy_building
+    game_cheat_destroy_building,
+    game_cheat_fast_forward
 };
 
 static const char *commands[] = {
@@ -100,7 +103,8 @@ static const char *commands[] = {
     "breadandfish",
     "leavemealone",
     "weather",                   // syntax: weather <weather_type> <intensity>
-    "destroy"                   // syntax: destroy <building_id> <destruction_type>
+    "destroy",                  // syntax: destroy <building_id> <destruction_type>
+    "fastforward"               // syntax: fastforward <months>
 };
 
 #define NUMBER_OF_COMMANDS sizeof (commands) / sizeof (commands[0])
@@ -393,6 +397,14 @@ static void game_cheat_destroy_building(uint8_t *args)
     show_warning(TR_CHEAT_DESTROYED_BUILDING);
 }
 
+static void game_cheat_fast_forward(uint8_t *args)
+{
+    // correct syntax = fastforward <months>
+    int months = 0;
+    parse_integer(args, &months);
+    window_fast_forward_show(months);
+}
+
 void game_cheat_parse_command(uint8_t *command)
 {
     uint8_t command_to_call[MAX_COMMAND_SIZE];
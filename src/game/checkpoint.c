@@ -0,0 +1,324 @@
+#include "checkpoint.h"
+
+#include "building/building.h"
+#include "core/buffer.h"
+#include "core/config.h"
+#include "core/dir.h"
+#include "core/file.h"
+#include "core/log.h"
+#include "core/random.h"
+#include "figure/figure.h"
+#include "figure/formation.h"
+#include "game/time.h"
+#include "map/aqueduct.h"
+#include "map/building.h"
+#include "map/desirability.h"
+#include "map/elevation.h"
+#include "map/figure.h"
+#include "map/grid.h"
+#include "map/property.h"
+#include "map/random.h"
+#include "map/sprite.h"
+#include "map/terrain.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TRACE_FILE "checkpoints.txt"
+#define REFERENCE_FILE "checkpoints-reference.txt"
+#define MAX_LINE_LENGTH 1024
+#define GRID_BUFFER_SIZE (GRID_SIZE * GRID_SIZE * 4)
+#define HASH_SEED 0xcbf29ce484222325ULL
+#define HASH_PRIME 0x100000001b3ULL
+// Ticks are negative for games set before year 0, so "none yet" needs to be below all of them
+#define NO_TICK INT_MIN
+
+typedef uint64_t (*hash_function)(void);
+
+static struct {
+    FILE *trace;
+    FILE *reference;
+    int files_opened;
+    int last_tick;
+    int has_diverged;
+    int reference_tick;
+    char reference_line[MAX_LINE_LENGTH];
+    uint8_t grids[3][GRID_BUFFER_SIZE];
+} data = { .last_tick = NO_TICK, .reference_tick = NO_TICK };
+
+static uint64_t hash_bytes(uint64_t hash, const uint8_t *bytes, size_t size)
+{
+    // FNV-1a on eight bytes at a time, read in a fixed byte order
+    while (size >= 8) {
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; i--) {
+            value = (value << 8) | bytes[i];
+        }
+        hash = (hash ^ value) * HASH_PRIME;
+        hash ^= hash >> 29;
+        bytes += 8;
+        size -= 8;
+    }
+    while (size--) {
+        hash = (hash ^ *bytes++) * HASH_PRIME;
+    }
+    return hash;
+}
+
+static uint64_t hash_buffer(uint64_t hash, const buffer *buf)
+{
+    return hash_bytes(hash, buf->data, buf->index);
+}
+
+static uint64_t hash_random(void)
+{
+    uint8_t iv[8];
+    buffer buf;
+    buffer_init(&buf, iv, sizeof(iv));
+    random_save_state(&buf);
+    return hash_buffer(HASH_SEED, &buf);
+}
+
+static uint64_t hash_buildings(void)
+{
+    uint8_t extra[24];
+    buffer buildings, highest_id, highest_id_ever, sequence, corrupt_houses;
+    buffer_init(&highest_id, extra, 4);
+    buffer_init(&highest_id_ever, extra + 4, 8);
+    buffer_init(&sequence, extra + 12, 4);
+    buffer_init(&corrupt_houses, extra + 16, 8);
+    building_save_state(&buildings, &highest_id, &highest_id_ever, &sequence, &corrupt_houses);
+    uint64_t hash = hash_buffer(HASH_SEED, &buildings);
+    free(buildings.data);
+    return hash_bytes(hash, extra, sizeof(extra));
+}
+
+static uint64_t hash_figures(void)
+{
+    uint8_t sequence_data[4];
+    buffer figures, sequence;
+    buffer_init(&sequence, sequence_data, sizeof(sequence_data));
+    figure_save_state(&figures, &sequence);
+    uint64_t hash = hash_buffer(HASH_SEED, &figures);
+    free(figures.data);
+    return hash_buffer(hash, &sequence);
+}
+
+static uint64_t hash_formations(void)
+{
+    uint8_t totals_data[12];
+    buffer formations, totals;
+    buffer_init(&totals, totals_data, sizeof(totals_data));
+    formations_save_state(&formations, &totals);
+    uint64_t hash = hash_buffer(HASH_SEED, &formations);
+    free(formations.data);
+    return hash_buffer(hash, &totals);
+}
+
+static uint64_t hash_grids(buffer *grids, int num_grids)
+{
+    uint64_t hash = HASH_SEED;
+    for (int i = 0; i < num_grids; i++) {
+        hash = hash_buffer(hash, &grids[i]);
+    }
+    return hash;
+}
+
+static void init_grid_buffers(buffer *grids)
+{
+    for (int i = 0; i < 3; i++) {
+        buffer_init(&grids[i], data.grids[i], GRID_BUFFER_SIZE);
+    }
+}
+
+static uint64_t hash_map_terrain(void)
+{
+    buffer grids[3];
+    init_grid_buffers(grids);
+    map_terrain_save_state(&grids[0]);
+    return hash_grids(grids, 1);
+}
+
+static uint64_t hash_map_buildings(void)
+{
+    buffer grids[3];
+    init_grid_buffers(grids);
+    map_building_save_state(&grids[0], &grids[1], &grids[2]);
+    return hash_grids(grids, 3);
+}
+
+static uint64_t hash_map_aqueducts(void)
+{
+    buffer grids[3];
+    init_grid_buffers(grids);
+    map_aqueduct_save_state(&grids[0], &grids[1]);
+    return hash_grids(grids, 2);
+}
+
+static uint64_t hash_map_figures(void)
+{
+    buffer grids[3];
+    init_grid_buffers(grids);
+    map_figure_save_state(&grids[0]);
+    return hash_grids(grids, 1);
+}
+
+static uint64_t hash_map_sprites(void)
+{
+    buffer grids[3];
+    init_grid_buffers(grids);
+    map_sprite_save_state(&grids[0], &grids[1]);
+    return hash_grids(grids, 2);
+}
+
+static uint64_t hash_map_properties(void)
+{
+    buffer grids[3];
+    init_grid_buffers(grids);
+    map_property_save_state(&grids[0], &grids[1]);
+    return hash_grids(grids, 2);
+}
+
+static uint64_t hash_map_desirability(void)
+{
+    buffer grids[3];
+    init_grid_buffers(grids);
+    map_desirability_save_state(&grids[0]);
+    return hash_grids(grids, 1);
+}
+
+static uint64_t hash_map_elevation(void)
+{
+    buffer grids[3];
+    init_grid_buffers(grids);
+    map_elevation_save_state(&grids[0]);
+    map_random_save_state(&grids[1]);
+    return hash_grids(grids, 2);
+}
+
+static const struct {
+    const char *name;
+    hash_function hash;
+} subsystems[] = {
+    { "random", hash_random },
+    { "buildings", hash_buildings },
+    { "figures", hash_figures },
+    { "formations", hash_formations },
+    { "map_terrain", hash_map_terrain },
+    { "map_buildings", hash_map_buildings },
+    { "map_aqueducts", hash_map_aqueducts },
+    { "map_figures", hash_map_figures },
+    { "map_sprites", hash_map_sprites },
+    { "map_properties", hash_map_properties },
+    { "map_desirability", hash_map_desirability },
+    { "map_elevation", hash_map_elevation }
+};
+
+#define NUM_SUBSYSTEMS (sizeof(subsystems) / sizeof(subsystems[0]))
+
+static int current_tick(void)
+{
+    int days = (game_time_year() * 12 + game_time_month()) * 16 + game_time_day();
+    return days * 50 + game_time_tick();
+}
+
+static void close_files(void)
+{
+    if (data.trace) {
+        file_close(data.trace);
+        data.trace = 0;
+    }
+    if (data.reference) {
+        file_close(data.reference);
+        data.reference = 0;
+    }
+    data.files_opened = 0;
+    data.has_diverged = 0;
+    data.reference_tick = NO_TICK;
+}
+
+static void open_files(void)
+{
+    // Only tried once per game, so a failure is not logged at every interval
+    data.files_opened = 1;
+    data.trace = file_open(dir_append_location(TRACE_FILE, PATH_LOCATION_ROOT), "w");
+    if (!data.trace) {
+        log_error("Unable to create checkpoint trace file", TRACE_FILE, 0);
+    }
+    if (config_get(CONFIG_DEBUG_CHECKPOINT_COMPARE)) {
+        data.reference = file_open(dir_append_location(REFERENCE_FILE, PATH_LOCATION_ROOT), "r");
+        if (!data.reference) {
+            log_error("Unable to open checkpoint reference file", REFERENCE_FILE, 0);
+        }
+    }
+}
+
+static int read_reference_line(int tick)
+{
+    while (data.reference_tick < tick) {
+        if (!fgets(data.reference_line, MAX_LINE_LENGTH, data.reference)) {
+            return 0;
+        }
+        data.reference_tick = atoi(data.reference_line);
+    }
+    return data.reference_tick == tick;
+}
+
+static void compare_with_reference(int tick, const uint64_t *hashes)
+{
+    if (!data.reference || data.has_diverged || !read_reference_line(tick)) {
+        return;
+    }
+    const char *token = strchr(data.reference_line, ' ');
+    for (int i = 0; i < NUM_SUBSYSTEMS && token; i++) {
+        uint64_t reference_hash = strtoull(token + 1, 0, 16);
+        if (reference_hash != hashes[i]) {
+            data.has_diverged = 1;
+            log_error("Simulation diverged from the reference checkpoints in subsystem", subsystems[i].name, tick);
+            return;
+        }
+        token = strchr(token + 1, ' ');
+    }
+}
+
+void game_checkpoint_process(void)
+{
+    int interval = config_get(CONFIG_DEBUG_CHECKPOINT_INTERVAL);
+    if (interval <= 0) {
+        return;
+    }
+    int tick = current_tick();
+    if (tick % interval) {
+        return;
+    }
+    if (tick <= data.last_tick) {
+        // Another game was loaded: start a new trace
+        close_files();
+    }
+    data.last_tick = tick;
+    if (!data.files_opened) {
+        open_files();
+    }
+
+    uint64_t hashes[NUM_SUBSYSTEMS];
+    for (int i = 0; i < NUM_SUBSYSTEMS; i++) {
+        hashes[i] = subsystems[i].hash();
+    }
+    if (data.trace) {
+        fprintf(data.trace, "%d", tick);
+        for (int i = 0; i < NUM_SUBSYSTEMS; i++) {
+            fprintf(data.trace, " %016llx", (unsigned long long) hashes[i]);
+        }
+        fprintf(data.trace, "\n");
+        fflush(data.trace);
+    }
+    compare_with_reference(tick, hashes);
+}
+
+void game_checkpoint_shutdown(void)
+{
+    close_files();
+    data.last_tick = NO_TICK;
+}
@@ -0,0 +1,25 @@
+#ifndef GAME_CHECKPOINT_H
+#define GAME_CHECKPOINT_H
+
+/**
+ * @file
+ * Deterministic state checkpoints, used to verify that changes to the simulation don't change its behaviour.
+ *
+ * When the checkpoint interval is set, a hash of each simulation subsystem is written to checkpoints.txt
+ * every time the game tick is a multiple of the interval. When comparing is also enabled, each checkpoint
+ * is compared to the one at the same tick in checkpoints-reference.txt, and the first subsystem that
+ * differs is logged. Traces should be compared between builds for the same architecture.
+ */
+
+/**
+ * Writes and compares the checkpoint for the current tick, if needed.
+ * Should be called after each game tick.
+ */
+void game_checkpoint_process(void);
+
+/**
+ * Closes the trace files
+ */
+void game_checkpoint_shutdown(void);
+
+#endif // GAME_CHECKPOINT_H
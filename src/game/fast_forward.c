@@ -0,0 +1,77 @@
+#include "fast_forward.h"
+
+#include "core/log.h"
+#include "game/file.h"
+#include "game/system.h"
+#include "game/tick.h"
+#include "game/time.h"
+#include "graphics/window.h"
+#include "widget/minimap.h"
+
+#define PROGRESS_UPDATE_MILLIS 250
+
+static struct {
+    int is_active;
+    int target_month;
+    unsigned int ticks;
+    uint64_t start_time;
+} data;
+
+static int current_month(void)
+{
+    return game_time_year() * 12 + game_time_month();
+}
+
+void game_fast_forward_start(int months)
+{
+    if (months <= 0) {
+        return;
+    }
+    data.is_active = 1;
+    data.target_month = current_month() + months;
+    data.ticks = 0;
+    data.start_time = system_get_ticks();
+}
+
+void game_fast_forward_stop(void)
+{
+    if (!data.is_active) {
+        return;
+    }
+    data.is_active = 0;
+    log_info("Fast forward ticks run:", 0, data.ticks);
+    log_info("Fast forward ticks per second:", 0, game_fast_forward_ticks_per_second());
+    widget_minimap_invalidate();
+    window_invalidate();
+}
+
+int game_fast_forward_is_active(void)
+{
+    return data.is_active;
+}
+
+void game_fast_forward_run(void)
+{
+    if (!data.is_active) {
+        return;
+    }
+    window_id id = window_get_id();
+    uint64_t end_time = system_get_ticks() + PROGRESS_UPDATE_MILLIS;
+    do {
+        game_tick_run();
+        game_file_write_mission_saved_game();
+        data.ticks++;
+
+        // Anything that opens a window, such as a message, victory or defeat, stops fast forwarding
+        if (current_month() >= data.target_month || window_get_id() != id) {
+            game_fast_forward_stop();
+            return;
+        }
+    } while (system_get_ticks() < end_time);
+}
+
+int game_fast_forward_ticks_per_second(void)
+{
+    uint64_t elapsed = system_get_ticks() - data.start_time;
+    return elapsed ? (int) (data.ticks * 1000 / elapsed) : 0;
+}
@@ -0,0 +1,33 @@
+#ifndef GAME_FAST_FORWARD_H
+#define GAME_FAST_FORWARD_H
+
+/**
+ * @file
+ * Runs the simulation as fast as possible until a given date, without drawing the city.
+ * Meant for testing long scenarios.
+ */
+
+/**
+ * Starts fast forwarding
+ * @param months The number of months to run the simulation for
+ */
+void game_fast_forward_start(int months);
+
+/**
+ * Stops fast forwarding and logs the achieved simulation speed
+ */
+void game_fast_forward_stop(void);
+
+int game_fast_forward_is_active(void);
+
+/**
+ * Runs simulation ticks until it's time to show progress again, or the target date is reached
+ */
+void game_fast_forward_run(void);
+
+/**
+ * Gets the average number of ticks run per second since fast forwarding started
+ */
+int game_fast_forward_ticks_per_second(void);
+
+#endif // GAME_FAST_FORWARD_H
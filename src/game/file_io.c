@@ -31,6 +31,7 @@
 #include "figure/trader.h"
 #include "figure/visited_buildings.h"
 #include "game/file.h"
+#include "game/save_summary.h"
 #include "game/save_version.h"
 #include "game/time.h"
 #include "game/tutorial.h"
@@ -1759,6 +1760,21 @@ static void get_saved_game_origin(saved_game_info *info, const savegame_state *s
     file_remove_extension(info->origin.campaign_name);
 }
 
+static void set_savegame_minimap_functions(void)
+{
+    minimap_data.functions.building = savegame_building;
+    minimap_data.functions.climate = get_climate;
+    minimap_data.functions.map.width = map_width;
+    minimap_data.functions.map.height = map_height;
+    minimap_data.functions.viewport = set_viewport;
+    minimap_data.functions.offset.building_id = savegame_get_building_id;
+    minimap_data.functions.offset.figure = 0;
+    minimap_data.functions.offset.is_draw_tile = savegame_is_draw_tile_at;
+    minimap_data.functions.offset.random = savegame_random_at;
+    minimap_data.functions.offset.terrain = savegame_terrain_at;
+    minimap_data.functions.offset.tile_size = savegame_tile_size_at;
+}
+
 static savegame_load_status savegame_read_file_info(saved_game_info *info, savegame_version_t version)
 {
     const savegame_state *state = &savegame_data.state;
@@ -1794,17 +1810,7 @@ static savegame_load_status savegame_read_file_info(saved_game_info *info, saveg
         &grid_start, &grid_border_size, scenario_version);
     info->map_size = minimap_data.city_width;
     minimap_data.climate = scenario_climate_from_buffer(state->scenario, scenario_version);
-    minimap_data.functions.building = savegame_building;
-    minimap_data.functions.climate = get_climate;
-    minimap_data.functions.map.width = map_width;
-    minimap_data.functions.map.height = map_height;
-    minimap_data.functions.viewport = set_viewport;
-    minimap_data.functions.offset.building_id = savegame_get_building_id;
-    minimap_data.functions.offset.figure = 0;
-    minimap_data.functions.offset.is_draw_tile = savegame_is_draw_tile_at;
-    minimap_data.functions.offset.random = savegame_random_at;
-    minimap_data.functions.offset.terrain = savegame_terrain_at;
-    minimap_data.functions.offset.tile_size = savegame_tile_size_at;
+    set_savegame_minimap_functions();
 
     city_view_set_custom_lookup(grid_start, minimap_data.city_width, minimap_data.city_height, grid_border_size);
     widget_minimap_update(&minimap_data.functions);
@@ -1851,6 +1857,30 @@ int game_file_io_read_saved_game_info(const char *filename, int offset, saved_ga
     return savegame_read_file_info(info, save_version);
 }
 
+int game_file_io_read_saved_game_summary(const char *filename, unsigned int modified_time, saved_game_info *info)
+{
+    const color_t *pixels;
+    int width, height, stride;
+    if (game_save_summary_find(filename, modified_time, info, &pixels, &width, &height)) {
+        // The minimap uses two by two pixels per tile
+        minimap_data.city_width = width / 2;
+        minimap_data.city_height = height / 2;
+        minimap_data.climate = info->climate;
+        set_savegame_minimap_functions();
+        if (widget_minimap_set_pixels(&minimap_data.functions, pixels, width, height)) {
+            return SAVEGAME_STATUS_OK;
+        }
+    }
+    int result = game_file_io_read_saved_game_info(filename, 0, info);
+    if (result == SAVEGAME_STATUS_OK) {
+        pixels = widget_minimap_get_pixels(&width, &height, &stride);
+        if (pixels) {
+            game_save_summary_store(filename, modified_time, info, pixels, width, height, stride);
+        }
+    }
+    return result;
+}
+
 int game_file_io_read_saved_game_info_from_buffer(buffer *buf, saved_game_info *info)
 {
     memset(info, 0, sizeof(saved_game_info));
@@ -1885,6 +1915,7 @@ int game_file_io_write_saved_game(const char *filename)
 
     log_info("Saving game", filename, 0);
     savegame_save_to_state(&savegame_data.state);
+    game_save_summary_forget(filename);
 
     FILE *fp = file_open(filename, "wb");
     if (!fp) {
@@ -1903,6 +1934,7 @@ int game_file_io_write_saved_game(const char *filename)
 int game_file_io_delete_saved_game(const char *filename)
 {
     log_info("Deleting game", filename, 0);
+    game_save_summary_forget(filename);
     int result = file_remove(filename);
     if (!result) {
         log_error("Unable to delete game", 0, 0);
@@ -51,6 +51,12 @@ int game_file_io_read_saved_game_info(const char *filename, int offset, saved_ga
 
 int game_file_io_read_saved_game_info_from_buffer(buffer *buf, saved_game_info *info);
 
+/**
+ * Same as game_file_io_read_saved_game_info, but returns the cached summary when the file did not change,
+ * instead of decompressing the whole saved game again
+ */
+int game_file_io_read_saved_game_summary(const char *filename, unsigned int modified_time, saved_game_info *info);
+
 int game_file_io_write_saved_game(const char *filename);
 
 int game_file_io_delete_saved_game(const char *filename);
@@ -11,15 +11,19 @@
 #include "core/log.h"
 #include "core/random.h"
 #include "core/string.h"
+#include "core/time.h"
 #include "editor/editor.h"
 #include "figure/type.h"
 #include "game/animation.h"
 #include "game/campaign.h"
+#include "game/checkpoint.h"
+#include "game/fast_forward.h"
 #include "game/file.h"
 #include "game/file_editor.h"
 #include "game/settings.h"
 #include "game/speed.h"
 #include "game/state.h"
+#include "game/system.h"
 #include "game/tick.h"
 #include "graphics/font.h"
 #include "graphics/graphics.h"
@@ -38,6 +42,8 @@
 #include "window/logo.h"
 #include "window/main_menu.h"
 
+#define SIMULATION_MILLIS_PER_FRAME 10
+
 static void errlog(const char *msg)
 {
     log_error(msg, 0, 0);
@@ -224,22 +230,35 @@ int game_reload_language(void)
 
 void game_run(void)
 {
+    if (game_fast_forward_is_active()) {
+        game_fast_forward_run();
+        return;
+    }
     game_animation_update();
     int num_ticks = game_speed_get_elapsed_ticks();
-    for (int i = 0; i < num_ticks; i++) {
+    // When decoupled, the simulation gets a fixed slice of each frame: drawing and input stay responsive
+    // at high speeds, and ticks left over from slow frames are caught up on the next ones
+    time_millis end_time = system_get_ticks() + SIMULATION_MILLIS_PER_FRAME;
+    int is_decoupled = config_get(CONFIG_GP_DECOUPLED_SIMULATION);
+    int ticks_done = 0;
+    while (ticks_done < num_ticks) {
         game_tick_run();
         game_file_write_mission_saved_game();
+        ticks_done++;
 
-        if (window_is_invalid()) {
+        if (window_is_invalid() || (is_decoupled && system_get_ticks() >= end_time)) {
             break;
         }
     }
+    game_speed_mark_ticks_done(ticks_done);
 }
 
 void game_draw(void)
 {
     window_draw(0);
-    sound_city_play();
+    if (!game_fast_forward_is_active()) {
+        sound_city_play();
+    }
 }
 
 void game_display_fps(int fps)
@@ -256,6 +275,7 @@ void game_display_fps(int fps)
 void game_exit(void)
 {
     video_shutdown();
+    game_checkpoint_shutdown();
     settings_save();
     config_save();
     sound_system_shutdown();
@@ -0,0 +1,417 @@
+#include "save_summary.h"
+
+#include "core/dir.h"
+#include "core/file.h"
+#include "core/log.h"
+#include "core/zlib_helper.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SUMMARY_CACHE_FILE "savegame_summaries.cache"
+#define SUMMARY_CACHE_VERSION 1
+#define MAX_MEMORY_SUMMARIES 8
+#define MAX_FILE_RECORDS 1024
+#define RECORDS_SIZE_STEP 64
+#define MIN_STALE_RECORDS_TO_COMPACT 8
+
+static const char SUMMARY_CACHE_MAGIC[8] = "AUGSUMRY";
+
+typedef struct {
+    char *filename;
+    unsigned int modified_time;
+    saved_game_info info;
+    color_t *pixels;
+    int width;
+    int height;
+    unsigned int last_used;
+} summary;
+
+typedef struct {
+    char *filename;
+    unsigned int modified_time;
+    long offset; // position of the saved game info in the cache file
+} file_record;
+
+static struct {
+    summary summaries[MAX_MEMORY_SUMMARIES];
+    unsigned int use_counter;
+    struct {
+        int loaded;
+        int has_header;
+        file_record *records;
+        int num_records;
+        int num_records_in_file; // including the ones superseded or forgotten since
+        int capacity;
+    } file;
+} data;
+
+static char *copy_filename(const char *filename)
+{
+    size_t length = strlen(filename) + 1;
+    char *copy = malloc(length);
+    if (copy) {
+        memcpy(copy, filename, length);
+    }
+    return copy;
+}
+
+static void clear_summary(summary *s)
+{
+    free(s->filename);
+    free(s->pixels);
+    memset(s, 0, sizeof(summary));
+}
+
+static summary *get_free_summary(void)
+{
+    summary *oldest = &data.summaries[0];
+    for (int i = 0; i < MAX_MEMORY_SUMMARIES; i++) {
+        summary *s = &data.summaries[i];
+        if (!s->filename) {
+            return s;
+        }
+        if (s->last_used < oldest->last_used) {
+            oldest = s;
+        }
+    }
+    clear_summary(oldest);
+    return oldest;
+}
+
+static void clear_records(void)
+{
+    for (int i = 0; i < data.file.num_records; i++) {
+        free(data.file.records[i].filename);
+    }
+    free(data.file.records);
+    data.file.records = 0;
+    data.file.num_records = 0;
+    data.file.num_records_in_file = 0;
+    data.file.capacity = 0;
+}
+
+static file_record *find_record(const char *filename)
+{
+    for (int i = 0; i < data.file.num_records; i++) {
+        if (strcmp(data.file.records[i].filename, filename) == 0) {
+            return &data.file.records[i];
+        }
+    }
+    return 0;
+}
+
+static void remove_record(const char *filename)
+{
+    file_record *record = find_record(filename);
+    if (!record) {
+        return;
+    }
+    free(record->filename);
+    *record = data.file.records[--data.file.num_records];
+}
+
+static void add_record(char *filename, unsigned int modified_time, long offset)
+{
+    remove_record(filename);
+    if (data.file.num_records == data.file.capacity) {
+        file_record *records = realloc(data.file.records,
+            sizeof(file_record) * (data.file.capacity + RECORDS_SIZE_STEP));
+        if (!records) {
+            free(filename);
+            return;
+        }
+        data.file.records = records;
+        data.file.capacity += RECORDS_SIZE_STEP;
+    }
+    file_record *record = &data.file.records[data.file.num_records++];
+    record->filename = filename;
+    record->modified_time = modified_time;
+    record->offset = offset;
+}
+
+static int read_u32(FILE *fp, uint32_t *value)
+{
+    return fread(value, sizeof(uint32_t), 1, fp) == 1;
+}
+
+static int read_header(FILE *fp)
+{
+    char magic[sizeof(SUMMARY_CACHE_MAGIC)];
+    uint32_t version;
+    uint32_t info_size;
+    return fread(magic, 1, sizeof(magic), fp) == sizeof(magic) &&
+        memcmp(magic, SUMMARY_CACHE_MAGIC, sizeof(magic)) == 0 &&
+        read_u32(fp, &version) && version == SUMMARY_CACHE_VERSION &&
+        read_u32(fp, &info_size) && info_size == sizeof(saved_game_info);
+}
+
+static void load_records(void)
+{
+    data.file.loaded = 1;
+    FILE *fp = file_open(dir_append_location(SUMMARY_CACHE_FILE, PATH_LOCATION_CONFIG), "rb");
+    if (!fp) {
+        return;
+    }
+    if (!read_header(fp)) {
+        file_close(fp);
+        return;
+    }
+    data.file.has_header = 1;
+    uint32_t name_length;
+    while (read_u32(fp, &name_length)) {
+        if (name_length == 0 || name_length >= FILE_NAME_MAX * 4) {
+            break;
+        }
+        char *filename = malloc(name_length + 1);
+        uint32_t modified_time;
+        uint32_t compressed_size;
+        if (!filename || fread(filename, 1, name_length, fp) != name_length || !read_u32(fp, &modified_time)) {
+            free(filename);
+            break;
+        }
+        filename[name_length] = 0;
+        long offset = ftell(fp);
+        if (fseek(fp, sizeof(saved_game_info) + 2 * sizeof(uint32_t), SEEK_CUR) ||
+            !read_u32(fp, &compressed_size) || fseek(fp, compressed_size, SEEK_CUR)) {
+            free(filename);
+            break;
+        }
+        add_record(filename, modified_time, offset);
+        data.file.num_records_in_file++;
+    }
+    file_close(fp);
+    if (data.file.num_records > MAX_FILE_RECORDS) {
+        // Most of the records are outdated by now, start over
+        clear_records();
+        data.file.has_header = 0;
+        file_remove(dir_append_location(SUMMARY_CACHE_FILE, PATH_LOCATION_CONFIG));
+    }
+}
+
+static int read_record(const file_record *record, summary *s)
+{
+    FILE *fp = file_open(dir_append_location(SUMMARY_CACHE_FILE, PATH_LOCATION_CONFIG), "rb");
+    if (!fp) {
+        return 0;
+    }
+    uint32_t width, height, compressed_size;
+    int result = 0;
+    void *compressed = 0;
+    if (fseek(fp, record->offset, SEEK_SET) == 0 &&
+        fread(&s->info, sizeof(saved_game_info), 1, fp) == 1 &&
+        read_u32(fp, &width) && read_u32(fp, &height) && read_u32(fp, &compressed_size) &&
+        width > 0 && height > 0 && width <= 1024 && height <= 1024) {
+        int pixels_size = (int) (sizeof(color_t) * width * height);
+        compressed = malloc(compressed_size);
+        s->pixels = malloc(pixels_size);
+        int decompressed_size;
+        if (compressed && s->pixels && fread(compressed, 1, compressed_size, fp) == compressed_size &&
+            zlib_helper_decompress(compressed, compressed_size, s->pixels, pixels_size, &decompressed_size)) {
+            s->width = width;
+            s->height = height;
+            result = 1;
+        }
+    }
+    free(compressed);
+    file_close(fp);
+    return result;
+}
+
+int game_save_summary_find(const char *filename, unsigned int modified_time, saved_game_info *info,
+    const color_t **pixels, int *width, int *height)
+{
+    summary *found = 0;
+    for (int i = 0; i < MAX_MEMORY_SUMMARIES; i++) {
+        summary *s = &data.summaries[i];
+        if (s->filename && s->modified_time == modified_time && strcmp(s->filename, filename) == 0) {
+            found = s;
+            break;
+        }
+    }
+    if (!found) {
+        if (!data.file.loaded) {
+            load_records();
+        }
+        const file_record *record = find_record(filename);
+        if (!record || record->modified_time != modified_time) {
+            return 0;
+        }
+        found = get_free_summary();
+        if (!read_record(record, found)) {
+            clear_summary(found);
+            return 0;
+        }
+        found->filename = copy_filename(filename);
+        found->modified_time = modified_time;
+        if (!found->filename) {
+            clear_summary(found);
+            return 0;
+        }
+    }
+    found->last_used = ++data.use_counter;
+    *info = found->info;
+    *pixels = found->pixels;
+    *width = found->width;
+    *height = found->height;
+    return 1;
+}
+
+static void write_u32(FILE *fp, uint32_t value)
+{
+    fwrite(&value, sizeof(uint32_t), 1, fp);
+}
+
+static void write_header(FILE *fp)
+{
+    fwrite(SUMMARY_CACHE_MAGIC, 1, sizeof(SUMMARY_CACHE_MAGIC), fp);
+    write_u32(fp, SUMMARY_CACHE_VERSION);
+    write_u32(fp, sizeof(saved_game_info));
+    data.file.has_header = 1;
+}
+
+static void discard_file(void)
+{
+    clear_records();
+    data.file.has_header = 0;
+    file_remove(dir_append_location(SUMMARY_CACHE_FILE, PATH_LOCATION_CONFIG));
+}
+
+static void compact_file(void)
+{
+    // Rewrites the cache file with only the records that are still in use
+    FILE *fp = file_open(dir_append_location(SUMMARY_CACHE_FILE, PATH_LOCATION_CONFIG), "rb");
+    if (!fp) {
+        discard_file();
+        return;
+    }
+    long size = -1;
+    if (fseek(fp, 0, SEEK_END) == 0) {
+        size = ftell(fp);
+    }
+    uint8_t *contents = size > 0 ? malloc(size) : 0;
+    if (!contents || fseek(fp, 0, SEEK_SET) || fread(contents, 1, size, fp) != (size_t) size) {
+        free(contents);
+        file_close(fp);
+        discard_file();
+        return;
+    }
+    file_close(fp);
+    fp = file_open(dir_append_location(SUMMARY_CACHE_FILE, PATH_LOCATION_CONFIG), "wb");
+    if (!fp) {
+        free(contents);
+        discard_file();
+        return;
+    }
+    write_header(fp);
+    int num_records = 0;
+    for (int i = 0; i < data.file.num_records; i++) {
+        file_record *record = &data.file.records[i];
+        long info_end = record->offset + sizeof(saved_game_info) + 3 * sizeof(uint32_t);
+        if (record->offset < 0 || info_end > size) {
+            free(record->filename);
+            continue;
+        }
+        uint32_t compressed_size;
+        memcpy(&compressed_size, &contents[info_end - sizeof(uint32_t)], sizeof(uint32_t));
+        if (compressed_size > (uint32_t) (size - info_end)) {
+            free(record->filename);
+            continue;
+        }
+        uint32_t name_length = (uint32_t) strlen(record->filename);
+        write_u32(fp, name_length);
+        fwrite(record->filename, 1, name_length, fp);
+        write_u32(fp, record->modified_time);
+        long offset = ftell(fp);
+        fwrite(&contents[record->offset], 1, info_end - record->offset + compressed_size, fp);
+        record->offset = offset;
+        data.file.records[num_records++] = *record;
+    }
+    file_close(fp);
+    free(contents);
+    data.file.num_records = num_records;
+    data.file.num_records_in_file = num_records;
+}
+
+static int has_too_many_stale_records(void)
+{
+    int stale_records = data.file.num_records_in_file - data.file.num_records;
+    return stale_records >= MIN_STALE_RECORDS_TO_COMPACT && stale_records > data.file.num_records;
+}
+
+static void write_record(const summary *s)
+{
+    if (!data.file.loaded) {
+        load_records();
+    }
+    if (has_too_many_stale_records()) {
+        compact_file();
+    }
+    int pixels_size = (int) (sizeof(color_t) * s->width * s->height);
+    int compressed_capacity = pixels_size + pixels_size / 1000 + 1024;
+    void *compressed = malloc(compressed_capacity);
+    int compressed_size;
+    if (!compressed || !zlib_helper_compress(s->pixels, pixels_size, compressed, compressed_capacity, &compressed_size)) {
+        free(compressed);
+        return;
+    }
+    char *filename = copy_filename(s->filename);
+    FILE *fp = filename ?
+        file_open(dir_append_location(SUMMARY_CACHE_FILE, PATH_LOCATION_CONFIG), data.file.has_header ? "ab" : "wb") : 0;
+    if (!fp) {
+        log_error("Unable to write the saved game summary cache", 0, 0);
+        free(filename);
+        free(compressed);
+        return;
+    }
+    if (!data.file.has_header) {
+        write_header(fp);
+    }
+    uint32_t name_length = (uint32_t) strlen(filename);
+    write_u32(fp, name_length);
+    fwrite(filename, 1, name_length, fp);
+    write_u32(fp, s->modified_time);
+    long offset = ftell(fp);
+    fwrite(&s->info, sizeof(saved_game_info), 1, fp);
+    write_u32(fp, s->width);
+    write_u32(fp, s->height);
+    write_u32(fp, compressed_size);
+    fwrite(compressed, 1, compressed_size, fp);
+    file_close(fp);
+    free(compressed);
+    add_record(filename, s->modified_time, offset);
+    data.file.num_records_in_file++;
+}
+
+void game_save_summary_store(const char *filename, unsigned int modified_time, const saved_game_info *info,
+    const color_t *pixels, int width, int height, int stride)
+{
+    game_save_summary_forget(filename);
+    summary *s = get_free_summary();
+    s->filename = copy_filename(filename);
+    s->pixels = malloc(sizeof(color_t) * width * height);
+    if (!s->filename || !s->pixels) {
+        clear_summary(s);
+        return;
+    }
+    for (int y = 0; y < height; y++) {
+        memcpy(&s->pixels[y * width], &pixels[y * stride], sizeof(color_t) * width);
+    }
+    s->modified_time = modified_time;
+    s->info = *info;
+    s->width = width;
+    s->height = height;
+    s->last_used = ++data.use_counter;
+    write_record(s);
+}
+
+void game_save_summary_forget(const char *filename)
+{
+    for (int i = 0; i < MAX_MEMORY_SUMMARIES; i++) {
+        if (data.summaries[i].filename && strcmp(data.summaries[i].filename, filename) == 0) {
+            clear_summary(&data.summaries[i]);
+        }
+    }
+    remove_record(filename);
+}
@@ -0,0 +1,40 @@
+#ifndef GAME_SAVE_SUMMARY_H
+#define GAME_SAVE_SUMMARY_H
+
+#include "game/file_io.h"
+#include "graphics/color.h"
+
+/**
+ * Looks up the summary of a saved game: its info and its rendered minimap.
+ * Summaries are kept in memory and in a cache file, keyed by path and modification time.
+ * @param filename Full path of the saved game
+ * @param modified_time Modification time of the file, as reported by the directory listing
+ * @param info Info to fill
+ * @param pixels Set to the minimap pixels, valid until the next call to any summary function
+ * @param width Set to the minimap width in pixels
+ * @param height Set to the minimap height in pixels
+ * @return 1 if a summary was found, 0 otherwise
+ */
+int game_save_summary_find(const char *filename, unsigned int modified_time, saved_game_info *info,
+    const color_t **pixels, int *width, int *height);
+
+/**
+ * Stores the summary of a saved game, in memory and in the cache file
+ * @param filename Full path of the saved game
+ * @param modified_time Modification time of the file
+ * @param info The info read from the saved game
+ * @param pixels The rendered minimap
+ * @param width Minimap width in pixels
+ * @param height Minimap height in pixels
+ * @param stride Minimap row length in pixels
+ */
+void game_save_summary_store(const char *filename, unsigned int modified_time, const saved_game_info *info,
+    const color_t *pixels, int width, int height, int stride);
+
+/**
+ * Drops the summary of a saved game that is about to be overwritten or deleted
+ * @param filename Full path of the saved game
+ */
+void game_save_summary_forget(const char *filename);
+
+#endif // GAME_SAVE_SUMMARY_H
@@ -1,6 +1,7 @@
 #include "game/speed.h"
 
 #include "building/construction.h"
+#include "core/config.h"
 #include "core/time.h"
 #include "game/settings.h"
 #include "game/state.h"
@@ -8,6 +9,7 @@
 #include "input/scroll.h"
 
 #define MAX_TICKS_PER_FRAME 20
+#define MAX_PENDING_TICK_MILLIS 1000
 
 static const time_millis MILLIS_PER_TICK_PER_SPEED[] = {
     702, 502, 352, 242, 162, 112, 82, 57, 37, 22, 16
@@ -20,6 +22,7 @@ const int game_speeds[] = { 10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 200, 300, 5
 static struct {
     int last_check_was_valid;
     time_millis last_update;
+    time_millis millis_per_tick;
 } data;
 
 int game_speed_get_index(int speed)
@@ -93,8 +96,19 @@ int game_speed_get_elapsed_ticks(void)
     if (!last_check_was_valid) {
         // returning to map from another window or pause: always force a tick
         data.last_update = now;
+        data.millis_per_tick = millis_per_tick;
         return 1;
     }
+    if (config_get(CONFIG_GP_DECOUPLED_SIMULATION)) {
+        // Ticks stay pending until they are marked as done, so the ones that don't fit
+        // in this frame are run on the next frames instead of being dropped
+        if (diff > MAX_PENDING_TICK_MILLIS) {
+            data.last_update = now - MAX_PENDING_TICK_MILLIS;
+            diff = MAX_PENDING_TICK_MILLIS;
+        }
+        data.millis_per_tick = millis_per_tick;
+        return diff / millis_per_tick;
+    }
     int ticks = diff / millis_per_tick;
     if (!ticks) {
         return 0;
@@ -106,3 +120,15 @@ int game_speed_get_elapsed_ticks(void)
         return MAX_TICKS_PER_FRAME;
     }
 }
+
+void game_speed_mark_ticks_done(int ticks)
+{
+    if (config_get(CONFIG_GP_DECOUPLED_SIMULATION)) {
+        data.last_update += ticks * data.millis_per_tick;
+        // A forced tick is not backed by elapsed time: never let the pending time go negative
+        time_millis now = time_get_millis();
+        if (data.last_update > now) {
+            data.last_update = now;
+        }
+    }
+}
@@ -6,4 +6,12 @@ int game_speed_get_index(int speed);
 int game_speed_get_speed(int index);
 int game_speed_get_elapsed_ticks(void);
 
+/**
+ * Marks ticks returned by game_speed_get_elapsed_ticks as run.
+ * Only has an effect when the simulation is decoupled from the frame rate,
+ * in which case ticks that are not marked as done are returned again on the next frame.
+ * @param ticks The number of ticks that were run
+ */
+void game_speed_mark_ticks_done(int ticks);
+
 #endif // GAME_SPEED_H
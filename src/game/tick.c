@@ -38,6 +38,8 @@
 #include "empire/city.h"
 #include "figure/formation.h"
 #include "figuretype/crime.h"
+#include "game/checkpoint.h"
+#include "game/fast_forward.h"
 #include "game/file.h"
 #include "game/settings.h"
 #include "game/time.h"
@@ -142,6 +144,14 @@ static void advance_day(void)
     scenario_events_process_all();
 }
 
+static void update_minimap(void)
+{
+    // The minimap is redrawn once fast forwarding ends
+    if (!game_fast_forward_is_active()) {
+        widget_minimap_invalidate();
+    }
+}
+
 static void advance_tick(void)
 {
     // NB: these ticks are noop:
@@ -150,7 +160,7 @@ static void advance_tick(void)
     switch (game_time_tick()) {
         case 1: city_gods_calculate_moods(1); break;
         case 2: sound_music_update(0); break;
-        case 3: widget_minimap_invalidate(); break;
+        case 3: update_minimap(); break;
         case 4: city_emperor_update(); break;
         case 5: formation_update_all(0); break;
         case 6: map_natives_check_land(1); break;
@@ -170,7 +180,7 @@ static void advance_tick(void)
         case 27: map_water_supply_update_reservoir_fountain(); break;
         case 28: map_water_supply_update_buildings(); break;
         case 29: formation_update_all(1); break;
-        case 30: widget_minimap_invalidate(); break;
+        case 30: update_minimap(); break;
         case 31: building_figure_generate(); break;
         case 32: city_trade_update(); break;
         case 33: building_entertainment_run_shows(); city_culture_update_coverage(); break;
@@ -210,6 +220,7 @@ void game_tick_run(void)
     scenario_gladiator_revolt_process();
     scenario_emperor_change_process();
     city_victory_check();
+    game_checkpoint_process();
 }
 
 void game_tick_cheat_year(void)
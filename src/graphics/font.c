@@ -251,6 +251,7 @@ static struct {
     const int *font_mapping;
     const font_definition *font_definitions;
     int multibyte;
+    unsigned int version;
 } data;
 
 static int image_y_offset_none(uint8_t c, int image_height, int line_height)
@@ -537,6 +538,17 @@ void font_set_encoding(encoding_type encoding)
         data.font_mapping = CHAR_TO_FONT_IMAGE_DEFAULT;
         data.font_definitions = DEFINITIONS_DEFAULT;
     }
+    font_mark_changed();
+}
+
+void font_mark_changed(void)
+{
+    data.version++;
+}
+
+unsigned int font_version(void)
+{
+    return data.version;
 }
 
 const font_definition *font_definition_for(font_t font)
@@ -43,6 +43,18 @@ typedef struct {
  */
 void font_set_encoding(encoding_type encoding);
 
+/**
+ * Signals that the font glyphs or their metrics have changed, e.g. because fonts were reloaded
+ */
+void font_mark_changed(void);
+
+/**
+ * Gets a number that changes whenever the encoding or the font glyphs change,
+ * so that cached text layouts can be discarded
+ * @return Font version
+ */
+unsigned int font_version(void);
+
 /**
  * Gets the font definition for the specified font
  * @param font Font
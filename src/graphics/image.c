@@ -5,6 +5,22 @@
 #include "graphics/renderer.h"
 #include "graphics/screen.h"
 
+typedef struct {
+    int texture_id;
+    int image_id;
+    int intensity;
+    int atlas_id;
+    int screen_width;
+    int screen_height;
+    unsigned int target_generation;
+} fullscreen_cache;
+
+// Composed fullscreen backgrounds, so that windows showing them every frame only need a single copy
+static struct {
+    fullscreen_cache plain;
+    fullscreen_cache blurred;
+} cache;
+
 void image_draw(int image_id, int x, int y, color_t color, float scale)
 {
     const image *img = image_get(image_id);
@@ -169,16 +185,50 @@ static inline void draw_fullscreen_borders(void)
     image_draw(image_base + 2, width - 16, height - 16, COLOR_MASK_NONE, SCALE_NONE);
 }
 
+static int is_cache_valid(const fullscreen_cache *c, int image_id, int intensity)
+{
+    return c->texture_id && c->image_id == image_id && c->intensity == intensity &&
+        c->atlas_id == image_get(image_id)->atlas.id &&
+        c->screen_width == screen_width() && c->screen_height == screen_height() &&
+        c->target_generation == graphics_renderer_target_generation();
+}
+
+static void save_to_cache(fullscreen_cache *c, int image_id, int intensity)
+{
+    int texture_id = graphics_renderer()->save_image_from_screen(c->texture_id, 0, 0, screen_width(), screen_height());
+    if (!texture_id) {
+        // Keep the texture for the next attempt, but don't draw its outdated contents
+        c->screen_width = 0;
+        return;
+    }
+    c->texture_id = texture_id;
+    c->image_id = image_id;
+    c->intensity = intensity;
+    c->atlas_id = image_get(image_id)->atlas.id;
+    c->screen_width = screen_width();
+    c->screen_height = screen_height();
+    c->target_generation = graphics_renderer_target_generation();
+}
+
 void image_draw_fullscreen_background(int image_id)
 {
     graphics_renderer()->clear_screen();
+    if (is_cache_valid(&cache.plain, image_id, 0)) {
+        graphics_renderer()->draw_image_to_screen(cache.plain.texture_id, 0, 0);
+        return;
+    }
     draw_fullscreen_background(image_id, 0, 0, ALPHA_OPAQUE);
     draw_fullscreen_borders();
+    save_to_cache(&cache.plain, image_id, 0);
 }
 
 void image_draw_blurred_fullscreen(int image_id, int intensity)
 {
     graphics_renderer()->clear_screen();
+    if (is_cache_valid(&cache.blurred, image_id, intensity)) {
+        graphics_renderer()->draw_image_to_screen(cache.blurred.texture_id, 0, 0);
+        return;
+    }
 
     color_t alpha = 0x80;
 
@@ -198,6 +248,7 @@ void image_draw_blurred_fullscreen(int image_id, int intensity)
 
         alpha -= alpha_step;
     }
+    save_to_cache(&cache.blurred, image_id, intensity);
 }
 
 void image_draw_border(int base_image_id, int x, int y, color_t color)
@@ -1,6 +1,7 @@
 #include "renderer.h"
 
 static const graphics_renderer_interface *renderer;
+static unsigned int target_generation;
 
 const graphics_renderer_interface *graphics_renderer(void)
 {
@@ -10,4 +11,15 @@ const graphics_renderer_interface *graphics_renderer(void)
 void graphics_renderer_set_interface(const graphics_renderer_interface *new_renderer)
 {
     renderer = new_renderer;
+    target_generation++;
+}
+
+void graphics_renderer_targets_reset(void)
+{
+    target_generation++;
+}
+
+unsigned int graphics_renderer_target_generation(void)
+{
+    return target_generation;
 }
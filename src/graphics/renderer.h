@@ -40,6 +40,13 @@ typedef struct {
     int *image_heights;
 } image_atlas_data;
 
+typedef struct {
+    int x_start;
+    int y_start;
+    int x_end;
+    int y_end;
+} line_segment;
+
 typedef struct {
     void (*clear_screen)(void);
 
@@ -50,6 +57,7 @@ typedef struct {
     void (*reset_clip_rectangle)(void);
 
     void (*draw_line)(int x_start, int x_end, int y_start, int y_end, color_t color);
+    void (*draw_lines)(const line_segment *lines, int count, color_t color);
     void (*draw_rect)(int x_start, int x_end, int y_start, int y_end, color_t color);
     void (*fill_rect)(int x_start, int x_end, int y_start, int y_end, color_t color);
 
@@ -76,6 +84,9 @@ typedef struct {
     void (*set_tooltip_position)(int x, int y);
     void (*set_tooltip_opacity)(int opacity);
 
+    int (*start_offscreen_rendering)(int width, int height);
+    void (*finish_offscreen_rendering)(void);
+
     int (*save_image_from_screen)(int image_id, int x, int y, int width, int height);
     void (*draw_image_to_screen)(int image_id, int x, int y);
     int (*save_screen_buffer)(color_t *pixels, int x, int y, int width, int height, int row_width);
@@ -100,4 +111,14 @@ const graphics_renderer_interface *graphics_renderer(void);
 
 void graphics_renderer_set_interface(const graphics_renderer_interface *new_renderer);
 
+/**
+ * Signals that the contents of the images saved from the screen were lost
+ */
+void graphics_renderer_targets_reset(void);
+
+/**
+ * Returns a number that changes whenever images saved from the screen lose their contents
+ */
+unsigned int graphics_renderer_target_generation(void);
+
 #endif // GRAPHICS_RENDERER_H
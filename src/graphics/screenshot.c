@@ -3,6 +3,7 @@
 #include "city/view.h"
 #include "city/warning.h"
 #include "core/buffer.h"
+#include "core/calc.h"
 #include "core/config.h"
 #include "core/file.h"
 #include "core/log.h"
@@ -14,6 +15,8 @@
 #include "graphics/screen.h"
 #include "graphics/window.h"
 #include "map/grid.h"
+#include "platform/file_manager.h"
+#include "platform/thread.h"
 #include "translation/translation.h"
 #include "widget/city/draw.h"
 #include "widget/minimap.h"
@@ -27,9 +30,22 @@
 
 #define TILE_X_SIZE 60
 #define TILE_Y_SIZE 30
-#define IMAGE_HEIGHT_CHUNK (TILE_Y_SIZE * 15)
 #define IMAGE_BYTES_PER_PIXEL 3
 #define MINIMAP_SCALE 2.0f
+#define FULL_CITY_TILE_SIZE 256
+#define FULL_CITY_TILE_ROWS_PER_BAND 2
+#define FULL_CITY_BAND_HEIGHT (FULL_CITY_TILE_SIZE * FULL_CITY_TILE_ROWS_PER_BAND)
+#define FULL_CITY_MARGIN_X (TILE_X_SIZE * 4)
+#define FULL_CITY_MARGIN_Y (TILE_Y_SIZE * 4)
+#define FULL_CITY_MIN_ZOOM 50
+#define FULL_CITY_MAX_ZOOM 400
+
+typedef struct {
+    color_t *pixels;
+    int rows;
+    FILE **tile_files;
+    int is_queued;
+} city_band;
 
 static struct {
     int width;
@@ -44,6 +60,21 @@ static struct {
     spng_ctx *ctx;
 } screenshot;
 
+static struct {
+    int width;
+    int stride;
+    int tiles_x;
+    int is_tiled;
+    int error;
+    int no_more_bands;
+    uint8_t *tile_pixels;
+    city_band bands[2];
+    platform_thread *thread;
+    platform_mutex *mutex;
+    platform_condition *band_queued;
+    platform_condition *band_done;
+} full_city;
+
 static void image_free(void)
 {
     screenshot.width = 0;
@@ -157,13 +188,13 @@ static int image_request_rows(void)
     return 0;
 }
 
-static int image_write_rows(const color_t *canvas, int canvas_width)
+static int image_write_rows(const color_t *canvas, int canvas_width, int rows)
 {
     int bytes_per_pixel = IMAGE_BYTES_PER_PIXEL;
     if (screenshot.alpha_channel) {
         bytes_per_pixel += 1;
     }
-    for (int y = 0; y < screenshot.rows_in_memory; ++y) {
+    for (int y = 0; y < rows; ++y) {
         uint8_t *pixel = screenshot.pixels;
         if (screenshot.alpha_channel) {
             for (int x = 0; x < screenshot.width; x++) {
@@ -205,7 +236,7 @@ static int image_write_canvas(void)
     int current_height = image_set_loop_height_limits(0, screenshot.height);
     int size;
     while ((size = image_request_rows()) != 0) {
-        if (!image_write_rows(canvas + current_height * screenshot.width, screenshot.width)) {
+        if (!image_write_rows(canvas + current_height * screenshot.width, screenshot.width, size)) {
             free(pixels);
             return 0;
         }
@@ -254,85 +285,374 @@ static void create_window_screenshot(void)
     image_free();
 }
 
+static int write_png_tile(FILE *fp, const color_t *pixels, int stride, uint8_t *rgb)
+{
+    uint8_t *pixel = rgb;
+    for (int y = 0; y < FULL_CITY_TILE_SIZE; y++) {
+        const color_t *input = &pixels[y * stride];
+        for (int x = 0; x < FULL_CITY_TILE_SIZE; x++) {
+            *(pixel + 0) = (uint8_t) COLOR_COMPONENT(input[x], COLOR_BITSHIFT_RED);
+            *(pixel + 1) = (uint8_t) COLOR_COMPONENT(input[x], COLOR_BITSHIFT_GREEN);
+            *(pixel + 2) = (uint8_t) COLOR_COMPONENT(input[x], COLOR_BITSHIFT_BLUE);
+            pixel += IMAGE_BYTES_PER_PIXEL;
+        }
+    }
+    spng_ctx *ctx = spng_ctx_new(SPNG_CTX_ENCODER);
+    if (!ctx) {
+        return 0;
+    }
+    struct spng_ihdr ihdr = {
+        .width = FULL_CITY_TILE_SIZE,
+        .height = FULL_CITY_TILE_SIZE,
+        .bit_depth = 8,
+        .color_type = SPNG_COLOR_TYPE_TRUECOLOR
+    };
+    int result = spng_set_option(ctx, SPNG_IMG_COMPRESSION_LEVEL, 1) || spng_set_png_file(ctx, fp) ||
+        spng_set_ihdr(ctx, &ihdr) ||
+        spng_encode_image(ctx, rgb, (size_t) FULL_CITY_TILE_SIZE * FULL_CITY_TILE_SIZE * IMAGE_BYTES_PER_PIXEL,
+            SPNG_FMT_PNG, SPNG_ENCODE_FINALIZE);
+    spng_ctx_free(ctx);
+    return result == 0;
+}
+
+static int encode_band(const city_band *band)
+{
+    if (!full_city.is_tiled) {
+        return image_write_rows(band->pixels, full_city.stride, band->rows);
+    }
+    for (int y = 0; y < FULL_CITY_TILE_ROWS_PER_BAND; y++) {
+        for (int x = 0; x < full_city.tiles_x; x++) {
+            FILE *fp = band->tile_files[y * full_city.tiles_x + x];
+            const color_t *pixels = &band->pixels[y * FULL_CITY_TILE_SIZE * full_city.stride + x * FULL_CITY_TILE_SIZE];
+            if (fp && !write_png_tile(fp, pixels, full_city.stride, full_city.tile_pixels)) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static void close_band_tile_files(city_band *band)
+{
+    if (!band->tile_files) {
+        return;
+    }
+    for (int i = 0; i < full_city.tiles_x * FULL_CITY_TILE_ROWS_PER_BAND; i++) {
+        if (band->tile_files[i]) {
+            file_close(band->tile_files[i]);
+            band->tile_files[i] = 0;
+        }
+    }
+}
+
+static int encode_bands_thread(void *unused)
+{
+    int index = 0;
+    while (1) {
+        city_band *band = &full_city.bands[index % 2];
+        platform_mutex_lock(full_city.mutex);
+        while (!band->is_queued && !full_city.no_more_bands) {
+            platform_condition_wait(full_city.band_queued, full_city.mutex);
+        }
+        int has_band = band->is_queued;
+        int skip = full_city.error;
+        platform_mutex_unlock(full_city.mutex);
+        if (!has_band) {
+            break;
+        }
+        int success = skip || encode_band(band);
+        platform_mutex_lock(full_city.mutex);
+        if (!success) {
+            full_city.error = 1;
+        }
+        band->is_queued = 0;
+        platform_condition_signal(full_city.band_done);
+        platform_mutex_unlock(full_city.mutex);
+        index++;
+    }
+    return 0;
+}
+
+static void start_band_encoder(void)
+{
+    full_city.mutex = platform_mutex_create();
+    full_city.band_queued = platform_condition_create();
+    full_city.band_done = platform_condition_create();
+    if (full_city.mutex && full_city.band_queued && full_city.band_done) {
+        full_city.thread = platform_thread_create(encode_bands_thread, "screenshot", 0);
+    }
+    if (!full_city.thread) {
+        log_info("Encoding full city screenshot on the main thread", 0, 0);
+    }
+}
+
+static city_band *acquire_band(int index)
+{
+    city_band *band = &full_city.bands[index % 2];
+    if (full_city.thread) {
+        platform_mutex_lock(full_city.mutex);
+        while (band->is_queued) {
+            platform_condition_wait(full_city.band_done, full_city.mutex);
+        }
+        platform_mutex_unlock(full_city.mutex);
+    }
+    close_band_tile_files(band);
+    return band;
+}
+
+static void submit_band(city_band *band)
+{
+    if (!full_city.thread) {
+        if (!encode_band(band)) {
+            full_city.error = 1;
+        }
+        return;
+    }
+    platform_mutex_lock(full_city.mutex);
+    band->is_queued = 1;
+    platform_condition_signal(full_city.band_queued);
+    platform_mutex_unlock(full_city.mutex);
+}
+
+static int has_encoding_error(void)
+{
+    if (!full_city.thread) {
+        return full_city.error;
+    }
+    platform_mutex_lock(full_city.mutex);
+    int error = full_city.error;
+    platform_mutex_unlock(full_city.mutex);
+    return error;
+}
+
+static int finish_band_encoder(void)
+{
+    if (full_city.thread) {
+        platform_mutex_lock(full_city.mutex);
+        full_city.no_more_bands = 1;
+        platform_condition_broadcast(full_city.band_queued);
+        platform_mutex_unlock(full_city.mutex);
+        platform_thread_wait(full_city.thread);
+    }
+    platform_condition_destroy(full_city.band_queued);
+    platform_condition_destroy(full_city.band_done);
+    platform_mutex_destroy(full_city.mutex);
+    for (int i = 0; i < 2; i++) {
+        close_band_tile_files(&full_city.bands[i]);
+        free(full_city.bands[i].tile_files);
+        free(full_city.bands[i].pixels);
+    }
+    free(full_city.tile_pixels);
+    int error = full_city.error;
+    memset(&full_city, 0, sizeof(full_city));
+    return error;
+}
+
+static int allocate_bands(void)
+{
+    for (int i = 0; i < 2; i++) {
+        full_city.bands[i].pixels = malloc(sizeof(color_t) * full_city.stride * FULL_CITY_BAND_HEIGHT);
+        if (!full_city.bands[i].pixels) {
+            return 0;
+        }
+        if (full_city.is_tiled) {
+            full_city.bands[i].tile_files = calloc(full_city.tiles_x * FULL_CITY_TILE_ROWS_PER_BAND, sizeof(FILE *));
+            if (!full_city.bands[i].tile_files) {
+                return 0;
+            }
+        }
+    }
+    if (full_city.is_tiled) {
+        full_city.tile_pixels = malloc((size_t) FULL_CITY_TILE_SIZE * FULL_CITY_TILE_SIZE * IMAGE_BYTES_PER_PIXEL);
+        if (!full_city.tile_pixels) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int open_band_tile_files(city_band *band, const char *directory, int band_index)
+{
+    char filename[FILE_NAME_MAX];
+    int tile_rows = (band->rows + FULL_CITY_TILE_SIZE - 1) / FULL_CITY_TILE_SIZE;
+    for (int y = 0; y < tile_rows; y++) {
+        int tile_y = band_index * FULL_CITY_TILE_ROWS_PER_BAND + y;
+        for (int x = 0; x < full_city.tiles_x; x++) {
+            snprintf(filename, FILE_NAME_MAX, "%s/%d_%d.png", directory, x, tile_y);
+            FILE *fp = file_open(filename, "wb");
+            if (!fp) {
+                log_error("Unable to write screenshot tile to:", filename, 0);
+                return 0;
+            }
+            band->tile_files[y * full_city.tiles_x + x] = fp;
+        }
+    }
+    return 1;
+}
+
+static int create_tile_directory(char *directory)
+{
+    char location[FILE_NAME_MAX];
+    snprintf(location, FILE_NAME_MAX, "%s",
+        platform_file_manager_get_directory_for_location(PATH_LOCATION_SCREENSHOT, 0));
+    snprintf(directory, FILE_NAME_MAX, "%s", generate_filename(SCREENSHOT_FULL_CITY));
+    char *extension = strrchr(directory, '.');
+    if (extension) {
+        *extension = 0;
+    }
+    return platform_file_manager_create_directory(directory, location, 1);
+}
+
+static void draw_city_section(color_t *pixels, int stride, int city_x, int city_y, int width, int height,
+    int scale, int target_width, int target_height)
+{
+    map_tile dummy_tile = { 0, 0, 0 };
+    // Keep the camera on a full tile row: the camera uses half-tile rows with a full-tile pixel remainder
+    city_view_set_camera_from_pixel_position(city_x, city_y - city_y % TILE_Y_SIZE);
+    graphics_clear_screen();
+    city_draw(0, 0, &dummy_tile, 0);
+
+    // The camera may have been clamped to the map edges, so find where the requested area actually ended up
+    int camera_x, camera_y;
+    city_view_get_camera_in_pixels(&camera_x, &camera_y);
+    int viewport_x, viewport_y, viewport_width, viewport_height;
+    city_view_get_viewport(&viewport_x, &viewport_y, &viewport_width, &viewport_height);
+    int screen_x = (viewport_x + city_x - camera_x) * 100 / scale;
+    int screen_y = (viewport_y + city_y - camera_y) * 100 / scale;
+    if (screen_x < 0) {
+        pixels -= screen_x;
+        width += screen_x;
+        screen_x = 0;
+    }
+    if (screen_y < 0) {
+        pixels -= screen_y * stride;
+        height += screen_y;
+        screen_y = 0;
+    }
+    if (screen_x + width > target_width) {
+        width = target_width - screen_x;
+    }
+    if (screen_y + height > target_height) {
+        height = target_height - screen_y;
+    }
+    if (width > 0 && height > 0) {
+        graphics_renderer()->save_screen_buffer(pixels, screen_x, screen_y, width, height, stride);
+    }
+}
+
 static void create_full_city_screenshot(void)
 {
     if (!window_is(WINDOW_CITY) && !window_is(WINDOW_CITY_MILITARY)) {
         return;
     }
+    if (!graphics_renderer()->start_offscreen_rendering) {
+        return;
+    }
     pixel_offset original_camera_pixels;
     city_view_get_camera_in_pixels(&original_camera_pixels.x, &original_camera_pixels.y);
+    int old_scale = city_view_get_scale();
+    int viewport_x, viewport_y, viewport_width, viewport_height;
+    city_view_get_viewport(&viewport_x, &viewport_y, &viewport_width, &viewport_height);
+    int sidebar_width = city_view_is_sidebar_collapsed() ? 42 : 162;
 
     int city_width_pixels = map_grid_width() * TILE_X_SIZE;
     int city_height_pixels = map_grid_height() * TILE_Y_SIZE;
+    int min_width = (GRID_SIZE * TILE_X_SIZE - city_width_pixels) / 2 + TILE_X_SIZE;
+    int max_height = (GRID_SIZE * TILE_Y_SIZE + city_height_pixels) / 2;
+    int min_height = max_height - city_height_pixels - TILE_Y_SIZE;
 
-    if (!image_create(city_width_pixels, city_height_pixels + TILE_Y_SIZE, 0, IMAGE_HEIGHT_CHUNK)) {
-        log_error("Unable to set memory for full city screenshot", 0, 0);
-        return;
-    }
-    const char *filename = generate_filename(SCREENSHOT_FULL_CITY);
-    if (!image_begin_io(filename) || !image_write_header()) {
-        log_error("Unable to write screenshot to:", filename, 0);
-        image_free();
-        return;
-    }
-
-    color_t *canvas = malloc(sizeof(color_t) * city_width_pixels * IMAGE_HEIGHT_CHUNK);
-    if (!canvas) {
-        image_free();
+    // Render large strips offscreen instead of small ones through the window
+    int max_texture_width, max_texture_height;
+    graphics_renderer()->get_max_image_size(&max_texture_width, &max_texture_height);
+    int strip_width = (max_texture_width - FULL_CITY_MARGIN_X - sidebar_width) / FULL_CITY_TILE_SIZE *
+        FULL_CITY_TILE_SIZE;
+    int target_height = FULL_CITY_BAND_HEIGHT + FULL_CITY_MARGIN_Y + TOP_MENU_HEIGHT;
+    if (strip_width <= 0 || target_height > max_texture_height) {
+        log_error("Unable to render full city screenshot: maximum texture size too small", 0, max_texture_width);
         return;
     }
-    memset(canvas, 0, sizeof(color_t) * city_width_pixels * IMAGE_HEIGHT_CHUNK);
-
-    int canvas_width = 8 * TILE_X_SIZE;
-    int old_scale = city_view_get_scale();
+    int target_width = strip_width + FULL_CITY_MARGIN_X + sidebar_width;
 
     int draw_cloud_shadows = config_get(CONFIG_UI_DRAW_CLOUD_SHADOWS);
     config_set(CONFIG_UI_DRAW_CLOUD_SHADOWS, 0);
+    city_view_set_viewport(target_width, target_height);
+    city_view_set_scale(calc_bound(config_get(CONFIG_UI_FULL_CITY_SCREENSHOT_ZOOM),
+        FULL_CITY_MIN_ZOOM, FULL_CITY_MAX_ZOOM));
+    int scale = city_view_get_scale();
 
-    int min_width = (GRID_SIZE * TILE_X_SIZE - city_width_pixels) / 2 + TILE_X_SIZE;
-    int max_height = (GRID_SIZE * TILE_Y_SIZE + city_height_pixels) / 2;
-    int min_height = max_height - city_height_pixels - TILE_Y_SIZE;
-    map_tile dummy_tile = { 0, 0, 0 };
+    int image_width = city_width_pixels * 100 / scale;
+    int image_height = (city_height_pixels + TILE_Y_SIZE) * 100 / scale;
+
+    full_city.is_tiled = config_get(CONFIG_UI_FULL_CITY_SCREENSHOT_TILED);
+    full_city.tiles_x = (image_width + FULL_CITY_TILE_SIZE - 1) / FULL_CITY_TILE_SIZE;
+    full_city.width = full_city.is_tiled ? full_city.tiles_x * FULL_CITY_TILE_SIZE : image_width;
+    full_city.stride = full_city.tiles_x * FULL_CITY_TILE_SIZE;
+
+    char filename[FILE_NAME_MAX];
     int error = 0;
-    int base_height = image_set_loop_height_limits(min_height, max_height);
-    int size;
-    city_view_set_scale(100);
-    graphics_set_clip_rectangle(0, TOP_MENU_HEIGHT, canvas_width, IMAGE_HEIGHT_CHUNK);
-    int viewport_x, viewport_y, viewport_width, viewport_height;
-    city_view_get_viewport(&viewport_x, &viewport_y, &viewport_width, &viewport_height);
-    city_view_set_viewport(canvas_width + (city_view_is_sidebar_collapsed() ? 42 : 162),
-        IMAGE_HEIGHT_CHUNK + TOP_MENU_HEIGHT);
-    int current_height = base_height;
-    while ((size = image_request_rows()) != 0) {
-        int y_offset = current_height + IMAGE_HEIGHT_CHUNK > max_height ?
-            IMAGE_HEIGHT_CHUNK - (max_height - current_height) - TILE_Y_SIZE : 0;
-        for (int width = 0; width < city_width_pixels; width += canvas_width) {
-            int image_section_width = canvas_width;
-            int x_offset = 0;
-            if (canvas_width + width > city_width_pixels) {
-                image_section_width = city_width_pixels - width;
-                x_offset = canvas_width - image_section_width - TILE_X_SIZE * 2;
-            }
-            city_view_set_camera_from_pixel_position(min_width + width, current_height);
-            city_draw(0, 0, &dummy_tile, 0);
-            graphics_renderer()->save_screen_buffer(&canvas[width], x_offset, TOP_MENU_HEIGHT + y_offset,
-                image_section_width, IMAGE_HEIGHT_CHUNK - y_offset, city_width_pixels);
+    if (full_city.is_tiled) {
+        if (!create_tile_directory(filename)) {
+            log_error("Unable to create screenshot directory:", filename, 0);
+            error = 1;
         }
-        if (!image_write_rows(canvas, city_width_pixels)) {
-            log_error("Error writing image", 0, 0);
+    } else if (!image_create(image_width, image_height, 0, FULL_CITY_BAND_HEIGHT)) {
+        log_error("Unable to set memory for full city screenshot", 0, 0);
+        error = 1;
+    } else {
+        snprintf(filename, FILE_NAME_MAX, "%s", generate_filename(SCREENSHOT_FULL_CITY));
+        if (!image_begin_io(filename) || !image_write_header()) {
+            log_error("Unable to write screenshot to:", filename, 0);
             error = 1;
-            break;
         }
-        current_height += IMAGE_HEIGHT_CHUNK;
     }
-    city_view_set_viewport(viewport_width + (city_view_is_sidebar_collapsed() ? 42 : 162), viewport_height + TOP_MENU_HEIGHT);
+    if (!error && !allocate_bands()) {
+        log_error("Unable to set memory for full city screenshot", 0, 0);
+        error = 1;
+    }
+    if (!error && !graphics_renderer()->start_offscreen_rendering(target_width, target_height)) {
+        log_error("Unable to create offscreen target for full city screenshot", 0, 0);
+        error = 1;
+    }
+
+    if (!error) {
+        graphics_reset_clip_rectangle();
+        start_band_encoder();
+        // While the worker compresses one band, the next one is drawn and read back
+        for (int band_index = 0, y = 0; y < image_height; band_index++, y += FULL_CITY_BAND_HEIGHT) {
+            city_band *band = acquire_band(band_index);
+            if (has_encoding_error()) {
+                error = 1;
+                break;
+            }
+            band->rows = image_height - y < FULL_CITY_BAND_HEIGHT ? image_height - y : FULL_CITY_BAND_HEIGHT;
+            memset(band->pixels, 0, sizeof(color_t) * full_city.stride * FULL_CITY_BAND_HEIGHT);
+            for (int x = 0; x < full_city.width; x += strip_width) {
+                int section_width = full_city.width - x < strip_width ? full_city.width - x : strip_width;
+                draw_city_section(&band->pixels[x], full_city.stride,
+                    min_width + x * scale / 100, min_height + y * scale / 100,
+                    section_width, FULL_CITY_BAND_HEIGHT, scale, target_width, target_height);
+            }
+            if (full_city.is_tiled && !open_band_tile_files(band, filename, band_index)) {
+                error = 1;
+                break;
+            }
+            submit_band(band);
+        }
+        error |= finish_band_encoder();
+        graphics_renderer()->finish_offscreen_rendering();
+    } else {
+        finish_band_encoder();
+    }
+
+    city_view_set_viewport(viewport_width + sidebar_width, viewport_height + TOP_MENU_HEIGHT);
     city_view_set_scale(old_scale);
     config_set(CONFIG_UI_DRAW_CLOUD_SHADOWS, draw_cloud_shadows);
-    graphics_reset_clip_rectangle();
     city_view_set_camera_from_pixel_position(original_camera_pixels.x, original_camera_pixels.y);
     if (!error) {
         log_info("Saved full city screenshot:", filename, 0);
         show_saved_notice(filename);
+    } else {
+        log_error("Error writing image", 0, 0);
     }
     image_free();
     window_invalidate();
@@ -368,7 +688,7 @@ static void create_minimap_screenshot(void)
     graphics_clear_screen();
     graphics_renderer()->draw_custom_image(CUSTOM_IMAGE_MINIMAP, 0, 0, 1 / MINIMAP_SCALE, 1);
     graphics_renderer()->save_screen_buffer(canvas, 0, 0, width_pixels, height_pixels, width_pixels);
-    if (image_write_rows(canvas, width_pixels)) {
+    if (image_write_rows(canvas, width_pixels, height_pixels)) {
         log_info("Saved city map screenshot:", filename, 0);
         show_saved_notice(filename);
     }
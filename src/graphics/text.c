@@ -8,13 +8,60 @@
 #include "graphics/graphics.h"
 #include "graphics/image.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #define ELLIPSIS_LENGTH 4
 #define NUMBER_BUFFER_LENGTH 100
 
+#define GLYPH_RUN_CACHE_SIZE 128
+#define MAX_GLYPH_RUN_LENGTH 128
+#define MULTILINE_CACHE_SIZE 16
+#define MAX_MULTILINE_LINES 100
+
 static uint8_t tmp_line[200];
 
+typedef struct {
+    int letter_id;
+    int x;
+    int y;
+} glyph;
+
+// Positions of the letters of a single line of text, relative to the draw position
+typedef struct {
+    unsigned int hash;
+    unsigned int font_version;
+    font_t font;
+    int length;
+    uint8_t text[MAX_GLYPH_RUN_LENGTH];
+    int num_glyphs;
+    glyph glyphs[MAX_GLYPH_RUN_LENGTH];
+    int width;
+} glyph_run;
+
+typedef struct {
+    int start;
+    int length;
+    int width;
+} text_line;
+
+// Line breaks of a multiline text for a given box width
+typedef struct {
+    unsigned int hash;
+    unsigned int font_version;
+    font_t font;
+    int box_width;
+    int length;
+    uint8_t *text;
+    int num_lines;
+    text_line lines[MAX_MULTILINE_LINES];
+} multiline_layout;
+
+static struct {
+    glyph_run glyph_runs[GLYPH_RUN_CACHE_SIZE];
+    multiline_layout multiline[MULTILINE_CACHE_SIZE];
+} layout_cache;
+
 static struct {
     int capture;
     int seen;
@@ -348,11 +395,76 @@ int text_draw_centered_ellipsized(const uint8_t *str, int x, int y, int box_widt
     return text_draw(buffer, x + offset, y, font, color);
 }
 
+static unsigned int hash_text(const uint8_t *str, int length, font_t font)
+{
+    // FNV-1a
+    unsigned int hash = 2166136261u ^ (unsigned int) font;
+    for (int i = 0; i < length; i++) {
+        hash ^= str[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static const glyph_run *get_glyph_run(const uint8_t *str, int length, const font_definition *def, font_t font)
+{
+    if (length >= MAX_GLYPH_RUN_LENGTH) {
+        return 0;
+    }
+    unsigned int hash = hash_text(str, length, font);
+    unsigned int version = font_version();
+    glyph_run *run = &layout_cache.glyph_runs[hash % GLYPH_RUN_CACHE_SIZE];
+    if (run->hash == hash && run->font_version == version && run->font == font &&
+        run->length == length && memcmp(run->text, str, length) == 0) {
+        return run;
+    }
+    run->hash = hash;
+    run->font_version = version;
+    run->font = font;
+    run->length = length;
+    memcpy(run->text, str, length);
+    run->num_glyphs = 0;
+
+    int current_x = 0;
+    while (length > 0) {
+        int num_bytes = 1;
+        if (*str == 0x01) { // special padding character
+            current_x += 1;
+        } else if (*str >= ' ') {
+            int letter_id = font_letter_id(def, str, &num_bytes);
+            if (*str == ' ' || *str == '_' || letter_id < 0) {
+                current_x += def->space_width;
+            } else {
+                const image *img = image_letter(letter_id);
+                glyph *g = &run->glyphs[run->num_glyphs++];
+                g->letter_id = letter_id;
+                g->x = current_x;
+                g->y = def->image_y_offset(*str, img->height + img->y_offset, def->line_height);
+                current_x += def->letter_spacing + img->original.width;
+            }
+        }
+        str += num_bytes;
+        length -= num_bytes;
+    }
+    run->width = current_x + def->space_width;
+    return run;
+}
+
 int text_draw_scaled(const uint8_t *str, int x, int y, font_t font, color_t color, float scale)
 {
     const font_definition *def = font_definition_for(font);
 
     int length = string_length(str);
+    if (!input_cursor.capture) {
+        const glyph_run *run = get_glyph_run(str, length, def, font);
+        if (run) {
+            for (int i = 0; i < run->num_glyphs; i++) {
+                const glyph *g = &run->glyphs[i];
+                image_draw_letter(def->font, g->letter_id, x + g->x, y - g->y, color, scale);
+            }
+            return run->width;
+        }
+    }
     if (input_cursor.capture) {
         str += input_cursor.text_offset_start;
         length = input_cursor.text_offset_end - input_cursor.text_offset_start;
@@ -669,26 +781,20 @@ void text_draw_number_centered_colored(
     text_draw_centered(str, x_offset, y_offset, box_width, font, color);
 }
 
-int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_width,
-    int centered, font_t font, color_t color)
+static int break_into_lines(const uint8_t *str, int box_width, font_t font, text_line *lines)
 {
-    int line_height = font_definition_for(font)->line_height;
-    if (line_height < 11) {
-        line_height = 11;
-    }
+    const uint8_t *text = str;
     int has_more_characters = 1;
     int guard = 0;
-    int y = y_offset;
+    int num_lines = 0;
     while (has_more_characters) {
-        if (++guard >= 100) {
+        if (++guard >= MAX_MULTILINE_LINES) {
             break;
         }
-        // clear line
-        for (int i = 0; i < 200; i++) {
-            tmp_line[i] = 0;
-        }
+        text_line *line = &lines[num_lines++];
+        line->start = 0;
+        line->length = 0;
         int current_width = 0;
-        int line_index = 0;
         while (has_more_characters) {
             int word_num_chars;
             int word_width = get_word_width(str, font, &word_num_chars, 0);
@@ -704,10 +810,14 @@ int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_
             }
             current_width += word_width;
             for (int i = 0; i < word_num_chars; i++) {
-                if (line_index == 0 && *str <= ' ') {
+                if (line->length == 0 && *str <= ' ') {
                     str++; // skip whitespace at start of line
                 } else {
-                    tmp_line[line_index++] = *str++;
+                    if (!line->length) {
+                        line->start = (int) (str - text);
+                    }
+                    line->length++;
+                    str++;
                 }
             }
             if (!*str) {
@@ -717,7 +827,63 @@ int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_
                 break;
             }
         }
-        int line_offset = centered ? (box_width - current_width) / 2 : 0;
+        line->width = current_width;
+    }
+    return num_lines;
+}
+
+static const multiline_layout *get_multiline_layout(const uint8_t *str, int box_width, font_t font)
+{
+    int length = string_length(str);
+    unsigned int hash = hash_text(str, length, font);
+    unsigned int version = font_version();
+    multiline_layout *layout = &layout_cache.multiline[(hash ^ (unsigned int) box_width) % MULTILINE_CACHE_SIZE];
+    if (layout->text && layout->hash == hash && layout->font_version == version && layout->font == font &&
+        layout->box_width == box_width && layout->length == length && memcmp(layout->text, str, length) == 0) {
+        return layout;
+    }
+    free(layout->text);
+    layout->text = malloc(length + 1);
+    if (!layout->text) {
+        return 0;
+    }
+    memcpy(layout->text, str, length + 1);
+    layout->hash = hash;
+    layout->font_version = version;
+    layout->font = font;
+    layout->box_width = box_width;
+    layout->length = length;
+    layout->num_lines = break_into_lines(layout->text, box_width, font, layout->lines);
+    return layout;
+}
+
+int text_draw_multiline(const uint8_t *str, int x_offset, int y_offset, int box_width,
+    int centered, font_t font, color_t color)
+{
+    int line_height = font_definition_for(font)->line_height;
+    if (line_height < 11) {
+        line_height = 11;
+    }
+    static text_line uncached_lines[MAX_MULTILINE_LINES];
+    const text_line *lines = uncached_lines;
+    int num_lines;
+    const multiline_layout *layout = input_cursor.capture ? 0 : get_multiline_layout(str, box_width, font);
+    if (layout) {
+        str = layout->text;
+        lines = layout->lines;
+        num_lines = layout->num_lines;
+    } else {
+        num_lines = break_into_lines(str, box_width, font, uncached_lines);
+    }
+    int y = y_offset;
+    for (int i = 0; i < num_lines; i++) {
+        int length = lines[i].length;
+        if (length >= (int) sizeof(tmp_line)) {
+            length = sizeof(tmp_line) - 1;
+        }
+        memcpy(tmp_line, str + lines[i].start, length);
+        tmp_line[length] = 0;
+        int line_offset = centered ? (box_width - lines[i].width) / 2 : 0;
         text_draw(tmp_line, x_offset + line_offset, y, font, color);
         y += line_height + 5;
     }
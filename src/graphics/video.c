@@ -3,12 +3,14 @@
 #include "core/config.h"
 #include "core/dir.h"
 #include "core/file.h"
+#include "core/log.h"
 #include "core/smacker.h"
 #include "core/time.h"
 #include "game/campaign.h"
 #include "game/system.h"
 #include "graphics/renderer.h"
 #include "platform/file_manager.h"
+#include "platform/thread.h"
 #include "sound/device.h"
 #include "sound/music.h"
 #include "sound/speech.h"
@@ -16,9 +18,10 @@
 #include "easyav1.h"
 #include "pl_mpeg/pl_mpeg.h"
 
+#include <stdlib.h>
 #include <string.h>
 
-#define MAX_FRAME_TIME_ADVANCE_MS (1.0 / 30.0)
+#define FRAME_QUEUE_SIZE 4
 
 typedef enum {
     VIDEO_TYPE_NONE = 0,
@@ -27,6 +30,25 @@ typedef enum {
     VIDEO_TYPE_AV1 = 3
 } video_type;
 
+typedef struct {
+    uint8_t *data;
+    int width;
+    int height;
+    int size;
+} video_plane;
+
+typedef struct {
+    double time;
+    time_millis decode_millis;
+    color_t *pixels;
+    video_plane planes[3];
+    struct {
+        uint8_t *data;
+        int size;
+        int capacity;
+    } audio;
+} video_frame;
+
 static struct {
     int is_playing;
     int is_ended;
@@ -45,7 +67,6 @@ static struct {
         time_millis start_render_millis;
         int current_frame;
         int draw_frame;
-        plm_frame_t *mpg_frame;
     } video;
     struct {
         int has_audio;
@@ -54,14 +75,79 @@ static struct {
         int rate;
     } audio;
     struct {
-        color_t *pixels;
-        int width;
-    } buffer;
+        video_frame frames[FRAME_QUEUE_SIZE];
+        int read_index;
+        int count;
+        int decoded_frames;
+        int is_finished;
+        int should_stop;
+        int use_yuv;
+        double audio_time;
+        platform_thread *thread;
+        platform_mutex *mutex;
+        platform_condition *frame_consumed;
+    } queue;
+    struct {
+        int frames_shown;
+        int frames_dropped;
+        int underruns;
+        time_millis total_decode_millis;
+        time_millis max_decode_millis;
+    } stats;
     int restart_music;
 } data;
 
+static void stop_decoder_thread(void)
+{
+    if (data.queue.thread) {
+        platform_mutex_lock(data.queue.mutex);
+        data.queue.should_stop = 1;
+        platform_condition_broadcast(data.queue.frame_consumed);
+        platform_mutex_unlock(data.queue.mutex);
+        platform_thread_wait(data.queue.thread);
+        data.queue.thread = 0;
+    }
+    if (data.queue.frame_consumed) {
+        platform_condition_destroy(data.queue.frame_consumed);
+        data.queue.frame_consumed = 0;
+    }
+    if (data.queue.mutex) {
+        platform_mutex_destroy(data.queue.mutex);
+        data.queue.mutex = 0;
+    }
+}
+
+static void free_frame_queue(void)
+{
+    for (int i = 0; i < FRAME_QUEUE_SIZE; i++) {
+        video_frame *frame = &data.queue.frames[i];
+        free(frame->pixels);
+        for (int p = 0; p < 3; p++) {
+            free(frame->planes[p].data);
+        }
+        free(frame->audio.data);
+    }
+    memset(&data.queue, 0, sizeof(data.queue));
+}
+
+static void log_frame_statistics(void)
+{
+    if (!data.stats.frames_shown) {
+        return;
+    }
+    log_info("Video frames shown:", 0, data.stats.frames_shown);
+    log_info("Video frames dropped:", 0, data.stats.frames_dropped);
+    log_info("Video decoder underruns:", 0, data.stats.underruns);
+    log_info("Video average decode time (ms):", 0,
+        (int) (data.stats.total_decode_millis / (data.stats.frames_shown + data.stats.frames_dropped)));
+    log_info("Video maximum decode time (ms):", 0, (int) data.stats.max_decode_millis);
+}
+
 static void close_decoder(void)
 {
+    // The decoder thread uses the smacker and plm handles, so it must be gone before they are closed
+    stop_decoder_thread();
+    free_frame_queue();
     if (data.s) {
         smacker_close(data.s);
         data.s = 0;
@@ -79,18 +165,6 @@ static void close_decoder(void)
     data.type = VIDEO_TYPE_NONE;
 }
 
-static void update_mpg_video(plm_t *plm, plm_frame_t *frame, void *user)
-{
-    data.video.draw_frame = 1;
-    data.video.current_frame++;
-    data.video.mpg_frame = frame;
-}
-
-static void update_mpg_audio(plm_t *mpeg, plm_samples_t *samples, void *user)
-{
-    sound_device_write_custom_music_data(samples->interleaved, sizeof(float) * samples->count * 2);
-}
-
 static int load_av1(const char *filename)
 {
     if (data.type == VIDEO_TYPE_SMK || data.type == VIDEO_TYPE_MPG) {
@@ -218,8 +292,6 @@ static int load_mpg(const char *filename)
 
     data.audio.has_audio = 0;
 
-    plm_set_video_decode_callback(data.plm, update_mpg_video, 0);
-
     if (config_get(CONFIG_GENERAL_ENABLE_VIDEO_SOUND) && plm_get_num_audio_streams(data.plm) > 0) {
         plm_set_audio_enabled(data.plm, 1);
         plm_set_audio_stream(data.plm, 0);
@@ -227,10 +299,8 @@ static int load_mpg(const char *filename)
         data.audio.bitdepth = 32;
         data.audio.channels = 2;
         data.audio.rate = plm_get_samplerate(data.plm);
-        plm_set_audio_decode_callback(data.plm, update_mpg_audio, 0);
     } else {
         plm_set_audio_enabled(data.plm, 0);
-        plm_set_audio_decode_callback(data.plm, 0, 0);
     }
 
     data.type = VIDEO_TYPE_MPG;
@@ -283,8 +353,186 @@ static int load_smk(const char *filename)
     return 1;
 }
 
+static int copy_frame_audio(video_frame *frame, const void *audio_data, int audio_len)
+{
+    if (frame->audio.size + audio_len > frame->audio.capacity) {
+        int capacity = (frame->audio.size + audio_len) * 2;
+        uint8_t *audio = realloc(frame->audio.data, capacity);
+        if (!audio) {
+            return 0;
+        }
+        frame->audio.data = audio;
+        frame->audio.capacity = capacity;
+    }
+    memcpy(frame->audio.data + frame->audio.size, audio_data, audio_len);
+    frame->audio.size += audio_len;
+    return 1;
+}
+
+static int copy_frame_plane(video_plane *dst, const plm_plane_t *src)
+{
+    int size = src->width * src->height;
+    if (size > dst->size) {
+        free(dst->data);
+        dst->data = malloc(size);
+        if (!dst->data) {
+            dst->size = 0;
+            return 0;
+        }
+        dst->size = size;
+    }
+    memcpy(dst->data, src->data, size);
+    dst->width = src->width;
+    dst->height = src->height;
+    return 1;
+}
+
+static int decode_smk_frame(video_frame *frame)
+{
+    // The first frame is decoded when the file is opened and its audio is handed over in video_init
+    if (data.queue.decoded_frames > 0) {
+        if (smacker_next_frame(data.s) != SMACKER_FRAME_OK) {
+            return 0;
+        }
+        if (data.audio.has_audio) {
+            int audio_len = smacker_get_frame_audio_size(data.s, 0);
+            if (audio_len > 0 && !copy_frame_audio(frame, smacker_get_frame_audio(data.s, 0), audio_len)) {
+                return 0;
+            }
+        }
+    }
+    const unsigned char *video = smacker_get_frame_video(data.s);
+    const uint32_t *pal = smacker_get_frame_palette(data.s);
+    if (video && pal) {
+        color_t *pixel = frame->pixels;
+        for (int y = 0; y < data.video.height; y++) {
+            int video_y = data.video.y_scale == SMACKER_Y_SCALE_NONE ? y : y / 2;
+            const unsigned char *line = video + (video_y * data.video.width);
+            for (int x = 0; x < data.video.width; x++) {
+                *pixel = ALPHA_OPAQUE | pal[line[x]];
+                ++pixel;
+            }
+        }
+    }
+    frame->time = data.queue.decoded_frames * (data.video.micros_per_frame / 1000000.0);
+    return 1;
+}
+
+static int decode_mpg_frame(video_frame *frame)
+{
+    plm_frame_t *video = plm_decode_video(data.plm);
+    if (!video) {
+        return 0;
+    }
+    if (data.queue.use_yuv) {
+        if (!copy_frame_plane(&frame->planes[0], &video->y) || !copy_frame_plane(&frame->planes[1], &video->cb) ||
+            !copy_frame_plane(&frame->planes[2], &video->cr)) {
+            return 0;
+        }
+    } else {
+        plm_frame_to_bgra(video, (uint8_t *) frame->pixels, data.video.width * sizeof(color_t));
+    }
+    frame->time = video->time;
+
+    // Keep the audio slightly ahead of the picture so the sound device never runs dry between frames
+    double audio_until = video->time + data.video.micros_per_frame / 1000000.0;
+    while (data.audio.has_audio && data.queue.audio_time < audio_until) {
+        plm_samples_t *samples = plm_decode_audio(data.plm);
+        if (!samples) {
+            break;
+        }
+        if (!copy_frame_audio(frame, samples->interleaved, sizeof(float) * samples->count * 2)) {
+            return 0;
+        }
+        data.queue.audio_time = samples->time;
+    }
+    return 1;
+}
+
+static int decode_next_frame(video_frame *frame)
+{
+    time_millis start = system_get_ticks();
+    frame->audio.size = 0;
+    int result = data.type == VIDEO_TYPE_SMK ? decode_smk_frame(frame) : decode_mpg_frame(frame);
+    if (result) {
+        data.queue.decoded_frames++;
+    }
+    frame->decode_millis = system_get_ticks() - start;
+    return result;
+}
+
+static int decode_frames_thread(void *userdata)
+{
+    while (1) {
+        platform_mutex_lock(data.queue.mutex);
+        while (data.queue.count == FRAME_QUEUE_SIZE && !data.queue.should_stop) {
+            platform_condition_wait(data.queue.frame_consumed, data.queue.mutex);
+        }
+        if (data.queue.should_stop) {
+            platform_mutex_unlock(data.queue.mutex);
+            return 0;
+        }
+        // The slot after the last queued frame is never touched by the main thread
+        video_frame *frame = &data.queue.frames[(data.queue.read_index + data.queue.count) % FRAME_QUEUE_SIZE];
+        platform_mutex_unlock(data.queue.mutex);
+
+        int decoded = decode_next_frame(frame);
+
+        platform_mutex_lock(data.queue.mutex);
+        if (decoded) {
+            data.queue.count++;
+        } else {
+            data.queue.is_finished = 1;
+        }
+        platform_mutex_unlock(data.queue.mutex);
+        if (!decoded) {
+            return 0;
+        }
+    }
+}
+
+static int start_frame_queue(void)
+{
+    data.queue.use_yuv = data.type == VIDEO_TYPE_MPG && graphics_renderer()->supports_yuv_image_format();
+    if (!data.queue.use_yuv) {
+        for (int i = 0; i < FRAME_QUEUE_SIZE; i++) {
+            data.queue.frames[i].pixels = malloc(sizeof(color_t) * data.video.width * data.video.height);
+            if (!data.queue.frames[i].pixels) {
+                log_error("Unable to allocate video frame buffer", 0, 0);
+                return 0;
+            }
+        }
+    }
+    data.queue.mutex = platform_mutex_create();
+    data.queue.frame_consumed = platform_condition_create();
+    if (data.queue.mutex && data.queue.frame_consumed) {
+        data.queue.thread = platform_thread_create(decode_frames_thread, "video_decoder", 0);
+    }
+    if (!data.queue.thread) {
+        // Without a decoder thread, frames are decoded on demand by the main thread
+        stop_decoder_thread();
+    }
+    return 1;
+}
+
+static void fill_frame_queue(double elapsed_time)
+{
+    // Only decode what is needed right now, plus one frame so the next draw has something to check
+    while (!data.queue.is_finished && data.queue.count < FRAME_QUEUE_SIZE &&
+        (data.queue.count == 0 ||
+        data.queue.frames[(data.queue.read_index + data.queue.count - 1) % FRAME_QUEUE_SIZE].time <= elapsed_time)) {
+        video_frame *frame = &data.queue.frames[(data.queue.read_index + data.queue.count) % FRAME_QUEUE_SIZE];
+        if (decode_next_frame(frame)) {
+            data.queue.count++;
+        } else {
+            data.queue.is_finished = 1;
+        }
+    }
+}
+
 static void end_video(void)
 {
+    log_frame_statistics();
     sound_device_use_default_music_player();
     if (data.restart_music) {
         sound_music_update(1);
@@ -302,9 +550,7 @@ int video_start(const char *filename)
         sound_speech_stop();
         int is_yuv = data.type != VIDEO_TYPE_SMK && graphics_renderer()->supports_yuv_image_format();
         graphics_renderer()->create_custom_image(CUSTOM_IMAGE_VIDEO, data.video.width, data.video.height, is_yuv);
-        if (!is_yuv) {
-            data.buffer.pixels = graphics_renderer()->get_custom_image_buffer(CUSTOM_IMAGE_VIDEO, &data.buffer.width);
-        }
+        memset(&data.stats, 0, sizeof(data.stats));
         if (data.type == VIDEO_TYPE_AV1) {
             easyav1_play(data.easyav1);
         }
@@ -342,6 +588,13 @@ void video_init(int restart_music)
                 audio_data, audio_len);
         }
     }
+    // Only start decoding ahead once the first frame's audio has been handed over, as the decoder reuses it
+    if ((data.type == VIDEO_TYPE_SMK || data.type == VIDEO_TYPE_MPG) && !start_frame_queue()) {
+        close_decoder();
+        data.is_ended = 1;
+        data.is_playing = 0;
+        end_video();
+    }
 }
 
 int video_is_finished(void)
@@ -368,50 +621,85 @@ void video_shutdown(void)
     }
 }
 
-static void get_next_frame(void)
+static void get_next_queued_frame(double elapsed_time)
 {
-    if (data.type == VIDEO_TYPE_NONE || (data.type == VIDEO_TYPE_SMK && !data.s) ||
-        (data.type == VIDEO_TYPE_MPG && !data.plm) ||
-        (data.type == VIDEO_TYPE_AV1 && !data.easyav1)) {
-        return;
+    if (!data.queue.thread) {
+        fill_frame_queue(elapsed_time);
+    } else {
+        platform_mutex_lock(data.queue.mutex);
+    }
+    int available = data.queue.count;
+    int is_finished = data.queue.is_finished;
+    if (data.queue.thread) {
+        platform_mutex_unlock(data.queue.mutex);
     }
-    time_millis now_millis = system_get_ticks();
 
-    if (data.type == VIDEO_TYPE_SMK) {
-        int frame_no = (now_millis - data.video.start_render_millis) * 1000 / data.video.micros_per_frame;
-        data.video.draw_frame = data.video.current_frame == 0;
-        while (frame_no > data.video.current_frame) {
-            if (smacker_next_frame(data.s) != SMACKER_FRAME_OK) {
+    int due = 0;
+    while (due < available && data.queue.frames[(data.queue.read_index + due) % FRAME_QUEUE_SIZE].time <= elapsed_time) {
+        due++;
+    }
+    if (!due) {
+        if (!available) {
+            if (is_finished) {
                 close_decoder();
                 data.is_ended = 1;
                 data.is_playing = 0;
                 end_video();
-                return;
+            } else {
+                data.stats.underruns++;
             }
-            data.video.current_frame++;
-            data.video.draw_frame = 1;
+        }
+        data.video.draw_frame = 0;
+        return;
+    }
 
-            if (data.audio.has_audio) {
-                int audio_len = smacker_get_frame_audio_size(data.s, 0);
-                const void *audio_data = smacker_get_frame_audio(data.s, 0);
-                if (audio_len > 0) {
-                    sound_device_write_custom_music_data(audio_data, audio_len);
-                }
-            }
+    // Due frames stay in the queue until they have been used, so the decoder can't overwrite them
+    for (int i = 0; i < due; i++) {
+        video_frame *frame = &data.queue.frames[(data.queue.read_index + i) % FRAME_QUEUE_SIZE];
+        if (frame->audio.size > 0) {
+            sound_device_write_custom_music_data(frame->audio.data, frame->audio.size);
         }
-    } else if (data.type == VIDEO_TYPE_MPG) {
-        double elapsed_time = (now_millis - data.video.start_render_millis) / 1000.0;
-        if (elapsed_time > MAX_FRAME_TIME_ADVANCE_MS) {
-            elapsed_time = MAX_FRAME_TIME_ADVANCE_MS;
-        }
-        plm_decode(data.plm, elapsed_time);
-        data.video.start_render_millis = now_millis;
-        if (plm_has_ended(data.plm)) {
-            close_decoder();
-            data.is_ended = 1;
-            data.is_playing = 0;
-            end_video();
+        data.stats.total_decode_millis += frame->decode_millis;
+        if (frame->decode_millis > data.stats.max_decode_millis) {
+            data.stats.max_decode_millis = frame->decode_millis;
         }
+    }
+    video_frame *frame = &data.queue.frames[(data.queue.read_index + due - 1) % FRAME_QUEUE_SIZE];
+    if (data.queue.use_yuv) {
+        graphics_renderer()->update_custom_image_yuv(CUSTOM_IMAGE_VIDEO,
+            frame->planes[0].data, frame->planes[0].width, frame->planes[1].data, frame->planes[1].width,
+            frame->planes[2].data, frame->planes[2].width);
+    } else {
+        graphics_renderer()->update_custom_image_from(CUSTOM_IMAGE_VIDEO, frame->pixels,
+            0, 0, data.video.width, data.video.height);
+    }
+    data.stats.frames_shown++;
+    data.stats.frames_dropped += due - 1;
+    data.video.current_frame += due;
+    data.video.draw_frame = 0;
+
+    if (data.queue.thread) {
+        platform_mutex_lock(data.queue.mutex);
+    }
+    data.queue.read_index = (data.queue.read_index + due) % FRAME_QUEUE_SIZE;
+    data.queue.count -= due;
+    if (data.queue.thread) {
+        platform_condition_signal(data.queue.frame_consumed);
+        platform_mutex_unlock(data.queue.mutex);
+    }
+}
+
+static void get_next_frame(void)
+{
+    if (data.type == VIDEO_TYPE_NONE || (data.type == VIDEO_TYPE_SMK && !data.s) ||
+        (data.type == VIDEO_TYPE_MPG && !data.plm) ||
+        (data.type == VIDEO_TYPE_AV1 && !data.easyav1)) {
+        return;
+    }
+    time_millis now_millis = system_get_ticks();
+
+    if (data.type == VIDEO_TYPE_SMK || data.type == VIDEO_TYPE_MPG) {
+        get_next_queued_frame((now_millis - data.video.start_render_millis) / 1000.0);
     } else if (data.type == VIDEO_TYPE_AV1) {
         if (data.audio.has_audio) {
             const easyav1_audio_frame *audio_frame = easyav1_get_audio_frame(data.easyav1);
@@ -438,44 +726,16 @@ static void get_next_frame(void)
 
 static void update_video_frame(void)
 {
-    if (data.type == VIDEO_TYPE_NONE) {
+    // Smacker and MPEG frames are uploaded straight from the frame queue
+    if (data.type != VIDEO_TYPE_AV1 || !data.easyav1) {
         return;
     }
-    if (data.type == VIDEO_TYPE_SMK) {
-        const unsigned char *frame = smacker_get_frame_video(data.s);
-        const uint32_t *pal = smacker_get_frame_palette(data.s);
-        if (frame && pal) {
-            for (int y = 0; y < data.video.height; y++) {
-                color_t *pixel = &data.buffer.pixels[y * data.buffer.width];
-                int video_y = data.video.y_scale == SMACKER_Y_SCALE_NONE ? y : y / 2;
-                const unsigned char *line = frame + (video_y * data.video.width);
-                for (int x = 0; x < data.video.width; x++) {
-                    *pixel = ALPHA_OPAQUE | pal[line[x]];
-                    ++pixel;
-                }
-            }
-        }
-    } else if (data.type == VIDEO_TYPE_MPG) {
-        if (graphics_renderer()->supports_yuv_image_format()) {
-            plm_frame_t *frame = data.video.mpg_frame;
-            graphics_renderer()->update_custom_image_yuv(CUSTOM_IMAGE_VIDEO, frame->y.data, frame->y.width,
-                frame->cb.data, frame->cb.width, frame->cr.data, frame->cr.width);
-            return;
-        }
-        plm_frame_to_bgra(data.video.mpg_frame, (uint8_t *) data.buffer.pixels, data.buffer.width * 4);
-    } else if (data.type == VIDEO_TYPE_AV1) {
-        if (!data.easyav1) {
-            return;
-        }
-        const easyav1_video_frame *frame = easyav1_get_video_frame(data.easyav1);
-        if (!frame || !graphics_renderer()->supports_yuv_image_format()) {
-            return;
-        }
-        graphics_renderer()->update_custom_image_yuv(CUSTOM_IMAGE_VIDEO, frame->data[0], (int) frame->stride[0],
-            frame->data[1], (int) frame->stride[1], frame->data[2], (int) frame->stride[2]);
+    const easyav1_video_frame *frame = easyav1_get_video_frame(data.easyav1);
+    if (!frame || !graphics_renderer()->supports_yuv_image_format()) {
         return;
     }
-    graphics_renderer()->update_custom_image(CUSTOM_IMAGE_VIDEO);
+    graphics_renderer()->update_custom_image_yuv(CUSTOM_IMAGE_VIDEO, frame->data[0], (int) frame->stride[0],
+        frame->data[1], (int) frame->stride[1], frame->data[2], (int) frame->stride[2]);
 }
 
 void video_draw(int x_offset, int y_offset, int width, int height)
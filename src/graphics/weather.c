@@ -7,6 +7,7 @@
 #include "game/settings.h"
 #include "graphics/color.h"
 #include "graphics/graphics.h"
+#include "graphics/renderer.h"
 #include "graphics/screen.h"
 #include "graphics/window.h"
 #include "scenario/property.h"
@@ -17,6 +18,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <math.h>
 
 static const int PARTICLE_SIZES_RAIN[] = { 1, 8, 15, 23, 30 }; //sets of arbitrary values for a noticeable difference
@@ -38,22 +40,28 @@ static int get_particle_size(const int *table, int idx)
     return table[idx];
 }
 
+// Particles are stored as separate arrays so the per-frame update loops run over plain
+// contiguous data, and the wind sines are applied through the angle sum identity
+// sin(a + b) = sin(a) * cos(b) + cos(a) * sin(b) with the per-particle part precomputed
 typedef struct {
-    int x;
-    int y;
+    int *x;
+    int *y;
+    int *speed;
+    int *dx;
 
     // For rain
-    int length;
-    int speed;
-    int wind_phase;
+    int *length;
+
+    // For rain, the wind phase and for snow, the drift phase
+    float *phase_sin;
+    float *phase_cos;
 
     // For snow
-    int drift_offset;
-    int prev_drift;
+    int *prev_drift;
 
     // For sand
-    int offset;
-} weather_element;
+    int *offset;
+} weather_particles;
 
 static struct {
     int weather_initialized;
@@ -74,7 +82,9 @@ static struct {
     weather_type displayed_type;
     weather_type last_type;
 
-    weather_element *elements;
+    weather_particles particles;
+    line_segment *segments;
+    int segments_capacity;
 
     struct {
         int active;
@@ -124,47 +134,100 @@ static int get_adjusted_intensity(void)
     return base * slider / 100;
 }
 
-void init_weather_element(weather_element *e, int type)
+static void set_phase(int i, float phase)
+{
+    data.particles.phase_sin[i] = sinf(phase);
+    data.particles.phase_cos[i] = cosf(phase);
+}
+
+static void init_weather_element(int i, int type)
 {
-    e->x = random_from_stdlib() % screen_width();
-    e->y = random_from_stdlib() % screen_height();
+    weather_particles *p = &data.particles;
+    p->x[i] = random_from_stdlib() % screen_width();
+    p->y[i] = random_from_stdlib() % screen_height();
 
     switch (type) {
         case WEATHER_RAIN:
-            e->length = get_particle_size(PARTICLE_SIZES_RAIN, config_get(CONFIG_WT_RAIN_LENGTH)) + random_from_stdlib() % 10;
-            e->speed = get_particle_size(PARTICLE_SPEEDS_RAIN, config_get(CONFIG_WT_RAIN_SPEED)) + random_from_stdlib() % 5;
+            p->length[i] = get_particle_size(PARTICLE_SIZES_RAIN, config_get(CONFIG_WT_RAIN_LENGTH)) + random_from_stdlib() % 10;
+            p->speed[i] = get_particle_size(PARTICLE_SPEEDS_RAIN, config_get(CONFIG_WT_RAIN_SPEED)) + random_from_stdlib() % 5;
             // Light rain: every drop shares the global wind cycle (uniform sweep).
             // Heavy rain: each drop sees the cycle at a different phase, so they
             // don't all change direction in lockstep.
             if (get_adjusted_intensity() < HEAVY_RAIN_THRESHOLD) {
-                e->wind_phase = 0;
+                set_phase(i, 0.0f);
             } else {
-                e->wind_phase = random_from_stdlib() % (HEAVY_RAIN_THRESHOLD / 2);
+                set_phase(i, (random_from_stdlib() % (HEAVY_RAIN_THRESHOLD / 2)) * 0.04f);
             }
             break;
         case WEATHER_SNOW:
-            // drift_offset is a per-flake phase so each flake samples the
+            // The drift phase is per flake so each flake samples the
             // sway cycle slightly out of step. prev_drift seeds the delta
             // tracker with the sway curve's current value so the flake doesn't
             // jump on its first rendered frame.
-            e->drift_offset = random_from_stdlib() % 300;
-            e->prev_drift = (int) (sinf(data.wind_angle * 0.021f
-                            + e->drift_offset * 0.02f) * 10.0f);
-            e->speed = get_particle_size(PARTICLE_SPEEDS_SNOW, config_get(CONFIG_WT_SNOW_SPEED)) + random_from_stdlib() % 2;
+            set_phase(i, (random_from_stdlib() % 300) * 0.02f);
+            p->prev_drift[i] = (int) (sinf(data.wind_angle * 0.021f) * p->phase_cos[i] * 10.0f
+                + cosf(data.wind_angle * 0.021f) * p->phase_sin[i] * 10.0f);
+            p->speed[i] = get_particle_size(PARTICLE_SPEEDS_SNOW, config_get(CONFIG_WT_SNOW_SPEED)) + random_from_stdlib() % 2;
             break;
         case WEATHER_SAND:
-            e->speed = get_particle_size(PARTICLE_SPEEDS_SAND, config_get(CONFIG_WT_SANDSTORM_SPEED)) + (random_from_stdlib() % 2);
-            e->offset = random_between_from_stdlib(0, 1000);
+            p->speed[i] = get_particle_size(PARTICLE_SPEEDS_SAND, config_get(CONFIG_WT_SANDSTORM_SPEED)) + (random_from_stdlib() % 2);
+            p->offset[i] = random_between_from_stdlib(0, 1000);
             break;
     }
 }
 
-static void weather_stop(void)
+static void free_particles(void)
+{
+    weather_particles *p = &data.particles;
+    free(p->x);
+    free(p->y);
+    free(p->speed);
+    free(p->dx);
+    free(p->length);
+    free(p->phase_sin);
+    free(p->phase_cos);
+    free(p->prev_drift);
+    free(p->offset);
+    memset(p, 0, sizeof(weather_particles));
+}
+
+static int allocate_particles(int count)
 {
-    if (data.elements) {
-        free(data.elements);
-        data.elements = 0;
+    free_particles();
+    weather_particles *p = &data.particles;
+    p->x = malloc(sizeof(int) * count);
+    p->y = malloc(sizeof(int) * count);
+    p->speed = malloc(sizeof(int) * count);
+    p->dx = malloc(sizeof(int) * count);
+    p->length = malloc(sizeof(int) * count);
+    p->phase_sin = malloc(sizeof(float) * count);
+    p->phase_cos = malloc(sizeof(float) * count);
+    p->prev_drift = malloc(sizeof(int) * count);
+    p->offset = malloc(sizeof(int) * count);
+    if (!p->x || !p->y || !p->speed || !p->dx || !p->length || !p->phase_sin || !p->phase_cos ||
+        !p->prev_drift || !p->offset) {
+        free_particles();
+        return 0;
+    }
+    return 1;
+}
+
+static line_segment *get_segments(int count)
+{
+    if (count > data.segments_capacity) {
+        line_segment *segments = realloc(data.segments, sizeof(line_segment) * count);
+        if (!segments) {
+            return 0;
+        }
+        data.segments = segments;
+        data.segments_capacity = count;
     }
+    return data.segments;
+}
+
+static void weather_stop(void)
+{
+    free_particles();
 
     data.weather_config.active = 0;
     data.weather_initialized = 0;
@@ -304,101 +367,120 @@ static void render_weather_overlay(void)
         apply_alpha(data.overlay_color, alpha));
 }
 
+static int get_visible_particle_count(void)
+{
+    int count = data.current_particle_count;
+    return count > data.last_elements_count ? data.last_elements_count : count;
+}
+
 static void draw_snow(void)
 {
-    if (!data.elements || data.current_particle_count == 0) {
+    if (!data.particles.x || data.current_particle_count == 0) {
         return;
     }
 
-    if (window_city_is_window_cityview() || window_city_simulated_weather(WEATHER_SNOW)) {
-        update_wind();
+    weather_particles *p = &data.particles;
+    int count = get_visible_particle_count();
+    line_segment *segments = get_segments(count * 2);
+    if (!segments) {
+        return;
     }
 
-    int max_particles = data.last_elements_count;
-    int count = data.current_particle_count;
-    if (count > max_particles) {
-        count = max_particles;
+    if (window_city_is_window_cityview() || window_city_simulated_weather(WEATHER_SNOW)) {
+        update_wind();
+        // Slow, bounded horizontal sway around the flake's spawn column.
+        // The drift oscillates in ±10px over ~5 seconds, with a per-flake
+        // phase offset so flakes don't sway in unison. We apply the delta
+        // (new - prev) so x naturally returns to center instead of running
+        // off-screen via accumulating per-frame perturbations.
+        float wind_sin = sinf(data.wind_angle * 0.021f) * 10.0f;
+        float wind_cos = cosf(data.wind_angle * 0.021f) * 10.0f;
+        for (int i = 0; i < count; ++i) {
+            int new_drift = (int) (wind_sin * p->phase_cos[i] + wind_cos * p->phase_sin[i]);
+            p->x[i] += new_drift - p->prev_drift[i];
+            p->prev_drift[i] = new_drift;
+            p->y[i] += p->speed[i];
+        }
     }
 
+    int sf_size = get_particle_size(PARTICLE_SIZES_SNOW, config_get(CONFIG_UI_WT_SNOWFLAKE_SIZE));
+    int sf_half = sf_size / 2;
     for (int i = 0; i < count; ++i) {
-        if (window_city_is_window_cityview() || window_city_simulated_weather(WEATHER_SNOW)) {
-            // Slow, bounded horizontal sway around the flake's spawn column.
-            // target_drift oscillates in ±10px over ~5 seconds, with a per-flake
-            // phase offset so flakes don't sway in unison. We apply the delta
-            // (new - prev) so x naturally returns to center instead of running
-            // off-screen via accumulating per-frame perturbations.
-            float target_drift = sinf(data.wind_angle * 0.021f
-                                + data.elements[i].drift_offset * 0.02f) * 10.0f;
-            int new_drift = (int) target_drift;
-            data.elements[i].x += new_drift - data.elements[i].prev_drift;
-            data.elements[i].prev_drift = new_drift;
-            data.elements[i].y += data.elements[i].speed;
-        }
-
-        int sf_size = get_particle_size(PARTICLE_SIZES_SNOW, config_get(CONFIG_UI_WT_SNOWFLAKE_SIZE));
-        int sf_half = sf_size / 2;
-        // horizontal arm of cross
-        graphics_draw_line(
-            data.elements[i].x,
-            data.elements[i].x + sf_size,
-            data.elements[i].y + sf_half,
-            data.elements[i].y + sf_half,
-            COLOR_WEATHER_SNOWFLAKE);
-        // vertical arm of cross
-        graphics_draw_line(
-            data.elements[i].x + sf_half,
-            data.elements[i].x + sf_half,
-            data.elements[i].y,
-            data.elements[i].y + sf_size,
-            COLOR_WEATHER_SNOWFLAKE);
-
-        if (data.elements[i].y >= screen_height() || data.elements[i].x <= 0 || data.elements[i].x >= screen_width()) {
-            init_weather_element(&data.elements[i], data.weather_config.type);
-            data.elements[i].y = -(int) (random_from_stdlib() % 30);
+        // horizontal and vertical arm of the cross
+        line_segment *horizontal = &segments[i * 2];
+        line_segment *vertical = &segments[i * 2 + 1];
+        horizontal->x_start = p->x[i];
+        horizontal->x_end = p->x[i] + sf_size;
+        horizontal->y_start = horizontal->y_end = p->y[i] + sf_half;
+        vertical->x_start = vertical->x_end = p->x[i] + sf_half;
+        vertical->y_start = p->y[i];
+        vertical->y_end = p->y[i] + sf_size;
+    }
+    graphics_draw_lines(segments, count * 2, COLOR_WEATHER_SNOWFLAKE);
+
+    int width = screen_width();
+    int height = screen_height();
+    for (int i = 0; i < count; ++i) {
+        if (p->y[i] >= height || p->x[i] <= 0 || p->x[i] >= width) {
+            init_weather_element(i, data.weather_config.type);
+            p->y[i] = -(int) (random_from_stdlib() % 30);
         }
     }
 }
 
 static void draw_sandstorm(void)
 {
-    if (!data.elements || data.current_particle_count == 0) {
+    if (!data.particles.x || data.current_particle_count == 0) {
         return;
     }
 
-    int max_particles = data.last_elements_count;
-    int count = data.current_particle_count;
-    if (count > max_particles) {
-        count = max_particles;
+    weather_particles *p = &data.particles;
+    int count = get_visible_particle_count();
+    line_segment *segments = get_segments(count);
+    if (!segments) {
+        return;
     }
 
-    for (int i = 0; i < count; ++i) {
-        if (window_city_is_window_cityview() || window_city_simulated_weather(WEATHER_SAND)) {
-            int wave = ((data.elements[i].y + data.elements[i].offset) % 10) - 5;
-            data.elements[i].x += data.elements[i].speed + (wave / 10);
+    if (window_city_is_window_cityview() || window_city_simulated_weather(WEATHER_SAND)) {
+        for (int i = 0; i < count; ++i) {
+            int wave = ((p->y[i] + p->offset[i]) % 10) - 5;
+            p->x[i] += p->speed[i] + (wave / 10);
         }
+    }
+
+    int sd_size = get_particle_size(PARTICLE_SIZES_SAND, config_get(CONFIG_UI_WT_SANDSTORM_SIZE));
+    for (int i = 0; i < count; ++i) {
+        segments[i].x_start = p->x[i];
+        segments[i].x_end = p->x[i] + sd_size;
+        segments[i].y_start = p->y[i];
+        segments[i].y_end = p->y[i] + sd_size;
+    }
+    graphics_draw_lines(segments, count, COLOR_WEATHER_SAND_PARTICLE);
 
-        int sd_size = get_particle_size(PARTICLE_SIZES_SAND, config_get(CONFIG_UI_WT_SANDSTORM_SIZE));
-        graphics_draw_line(
-            data.elements[i].x,
-            data.elements[i].x + sd_size,
-            data.elements[i].y,
-            data.elements[i].y + sd_size,
-            COLOR_WEATHER_SAND_PARTICLE);
-
-        if (data.elements[i].x > screen_width()) {
-            init_weather_element(&data.elements[i], data.weather_config.type);
-            data.elements[i].x = 0;
+    int width = screen_width();
+    for (int i = 0; i < count; ++i) {
+        if (p->x[i] > width) {
+            init_weather_element(i, data.weather_config.type);
+            p->x[i] = 0;
         }
     }
 }
 
 static void draw_rain(void)
 {
-    if (!data.elements || data.current_particle_count == 0) {
+    if (!data.particles.x || data.current_particle_count == 0) {
         return;
     }
 
-    if (window_city_is_window_cityview() || window_city_simulated_weather(WEATHER_RAIN)) {
+    weather_particles *p = &data.particles;
+    int count = get_visible_particle_count();
+    line_segment *segments = get_segments(count);
+    if (!segments) {
+        return;
+    }
+
+    int is_simulated = window_city_is_window_cityview() || window_city_simulated_weather(WEATHER_RAIN);
+    if (is_simulated) {
         update_wind();
     }
 
@@ -406,44 +488,47 @@ static void draw_rain(void)
     int adjusted_intensity = get_adjusted_intensity();
     int base_speed = 3 + wind_strength + (adjusted_intensity / (HEAVY_RAIN_THRESHOLD / 2));
 
-    int max_particles = data.last_elements_count;
-    int count = data.current_particle_count;
-    if (count > max_particles) {
-        count = max_particles;
-    }
-
     // Global wind shared by every drop: dominant horizontal direction.
     float global_w = sinf(data.wind_angle * 0.011f) * 1.5f
                    + sinf(data.wind_angle * 0.025f) * 0.8f;
 
-    for (int i = 0; i < count; ++i) {
-        // Light rain: drops follow the global wind exactly (uniform sweep).
-        // Heavy rain: small per-particle perturbation (±0.5) staggers the
-        // moment each drop switches direction at rounding boundaries.
-        float pp = 0.0f;
-        if (adjusted_intensity >= HEAVY_RAIN_THRESHOLD) {
-            pp = sinf((data.wind_angle + data.elements[i].wind_phase) * 0.04f) * 0.5f;
+    // Light rain: drops follow the global wind exactly (uniform sweep).
+    // Heavy rain: small per-particle perturbation (±0.5) staggers the
+    // moment each drop switches direction at rounding boundaries.
+    if (adjusted_intensity >= HEAVY_RAIN_THRESHOLD) {
+        float wind_sin = sinf(data.wind_angle * 0.04f) * 0.5f;
+        float wind_cos = cosf(data.wind_angle * 0.04f) * 0.5f;
+        for (int i = 0; i < count; ++i) {
+            p->dx[i] = (int) (global_w + wind_sin * p->phase_cos[i] + wind_cos * p->phase_sin[i]);
         }
-        int dx = (int) (global_w + pp);
-
-        graphics_draw_line(
-            data.elements[i].x,
-            data.elements[i].x + dx * 2,
-            data.elements[i].y,
-            data.elements[i].y + data.elements[i].length,
-            COLOR_WEATHER_DROPS);
+    } else {
+        int dx = (int) global_w;
+        for (int i = 0; i < count; ++i) {
+            p->dx[i] = dx;
+        }
+    }
 
-        if (window_city_is_window_cityview() || window_city_simulated_weather(WEATHER_RAIN)) {
-            data.elements[i].x += dx;
+    for (int i = 0; i < count; ++i) {
+        segments[i].x_start = p->x[i];
+        segments[i].x_end = p->x[i] + p->dx[i] * 2;
+        segments[i].y_start = p->y[i];
+        segments[i].y_end = p->y[i] + p->length[i];
+    }
+    graphics_draw_lines(segments, count, COLOR_WEATHER_DROPS);
 
-            int dy = base_speed + data.elements[i].speed
-                   + (((data.elements[i].x + data.elements[i].y) % 3) - 1);
-            data.elements[i].y += dy;
+    if (is_simulated) {
+        for (int i = 0; i < count; ++i) {
+            p->x[i] += p->dx[i];
+            p->y[i] += base_speed + p->speed[i] + (((p->x[i] + p->y[i]) % 3) - 1);
         }
+    }
 
-        if (data.elements[i].y >= screen_height() || data.elements[i].x <= 0 || data.elements[i].x >= screen_width()) {
-            init_weather_element(&data.elements[i], data.weather_config.type);
-            data.elements[i].y = 0;
+    int width = screen_width();
+    int height = screen_height();
+    for (int i = 0; i < count; ++i) {
+        if (p->y[i] >= height || p->x[i] <= 0 || p->x[i] >= width) {
+            init_weather_element(i, data.weather_config.type);
+            p->y[i] = 0;
         }
     }
 
@@ -513,21 +598,17 @@ void update_weather(void)
 
     int target_count = get_adjusted_intensity();
     if (target_count != data.last_elements_count && target_count > 0) {
-        if (data.elements) {
-            free(data.elements);
-            data.elements = 0;
-        }
-        data.elements = malloc(sizeof(weather_element) * target_count);
-        for (int i = 0; i < target_count; ++i) {
-            init_weather_element(&data.elements[i], data.weather_config.type);
+        if (allocate_particles(target_count)) {
+            for (int i = 0; i < target_count; ++i) {
+                init_weather_element(i, data.weather_config.type);
+            }
+            data.last_elements_count = target_count;
+        } else {
+            data.last_elements_count = 0;
         }
-        data.last_elements_count = target_count;
         data.weather_initialized = 1;
     } else if (target_count == 0 && data.current_particle_count == 0) {
-        if (data.elements) {
-            free(data.elements);
-            data.elements = 0;
-        }
+        free_particles();
         data.last_elements_count = 0;
     }
 
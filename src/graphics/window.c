@@ -18,6 +18,7 @@ static struct {
     window_type *current_window;
     int refresh_immediate;
     int refresh_on_draw;
+    unsigned int refresh_version;
     int underlying_windows_redrawing;
 } data;
 
@@ -57,6 +58,7 @@ void window_invalidate(void)
 {
     data.refresh_immediate = 1;
     data.refresh_on_draw = 1;
+    data.refresh_version++;
 }
 
 int window_is_invalid(void)
@@ -67,6 +69,12 @@ int window_is_invalid(void)
 void window_request_refresh(void)
 {
     data.refresh_on_draw = 1;
+    data.refresh_version++;
+}
+
+unsigned int window_refresh_version(void)
+{
+    return data.refresh_version;
 }
 
 int window_is(window_id id)
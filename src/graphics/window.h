@@ -98,7 +98,8 @@ typedef enum {
     WINDOW_CUSTOM_MESSAGE,
     WINDOW_TEXT_INPUT,
     WINDOW_USER_PATH_SETUP,
-    WINDOW_EDITOR_SELECT_CITY_RESOURCES_FOR_ROUTE
+    WINDOW_EDITOR_SELECT_CITY_RESOURCES_FOR_ROUTE,
+    WINDOW_FAST_FORWARD
 } window_id;
 
 typedef struct {
@@ -126,6 +127,11 @@ void window_request_refresh(void);
  */
 int window_is_invalid(void);
 
+/**
+ * Returns a number that changes whenever the window is invalidated or a refresh is requested
+ */
+unsigned int window_refresh_version(void);
+
 void window_draw(int force);
 
 void window_draw_underlying_window(void);
@@ -9,6 +9,8 @@
 #include "map/terrain.h"
 
 #define MAX_TILES 8
+#define MAX_PATTERNS (1 << MAX_TILES)
+#define NO_CONTEXT 0xff
 
 struct terrain_image_context {
     const unsigned char tiles[MAX_TILES];
@@ -291,6 +293,12 @@ static struct {
     {terrain_images_aqueduct, 16}
 };
 
+// For every group, the index of the first context matching each combination of neighbouring tiles
+static struct {
+    unsigned char context_for_pattern[CONTEXT_MAX_ITEMS][MAX_PATTERNS];
+    int is_built;
+} lookup;
+
 static void clear_current_offset(struct terrain_image_context *items, int num_items)
 {
     for (int i = 0; i < num_items; i++) {
@@ -298,11 +306,46 @@ static void clear_current_offset(struct terrain_image_context *items, int num_it
     }
 }
 
+static int context_matches_tiles(const struct terrain_image_context *context, const int tiles[MAX_TILES])
+{
+    for (int i = 0; i < MAX_TILES; i++) {
+        if (context->tiles[i] != 2 && tiles[i] != context->tiles[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void build_lookup(void)
+{
+    for (int group = 0; group < CONTEXT_MAX_ITEMS; group++) {
+        const struct terrain_image_context *context = context_pointers[group].context;
+        int size = context_pointers[group].size;
+        for (int pattern = 0; pattern < MAX_PATTERNS; pattern++) {
+            int tiles[MAX_TILES];
+            for (int i = 0; i < MAX_TILES; i++) {
+                tiles[i] = (pattern >> i) & 1;
+            }
+            lookup.context_for_pattern[group][pattern] = NO_CONTEXT;
+            for (int i = 0; i < size; i++) {
+                if (context_matches_tiles(&context[i], tiles)) {
+                    lookup.context_for_pattern[group][pattern] = i;
+                    break;
+                }
+            }
+        }
+    }
+    lookup.is_built = 1;
+}
+
 void map_image_context_init(void)
 {
     for (int i = 0; i < CONTEXT_MAX_ITEMS; i++) {
         clear_current_offset(context_pointers[i].context, context_pointers[i].size);
     }
+    if (!lookup.is_built) {
+        build_lookup();
+    }
 }
 
 void map_image_context_reset_water(void)
@@ -315,36 +358,31 @@ void map_image_context_reset_elevation(void)
     clear_current_offset(context_pointers[CONTEXT_ELEVATION].context, context_pointers[CONTEXT_ELEVATION].size);
 }
 
-static int context_matches_tiles(const struct terrain_image_context *context, const int tiles[MAX_TILES])
-{
-    for (int i = 0; i < MAX_TILES; i++) {
-        if (context->tiles[i] != 2 && tiles[i] != context->tiles[i]) {
-            return 0;
-        }
-    }
-    return 1;
-}
-
 static const terrain_image *get_image(int group, int tiles[MAX_TILES])
 {
     static terrain_image result;
 
-    result.is_valid = 0;
-    struct terrain_image_context *context = context_pointers[group].context;
-    int size = context_pointers[group].size;
-    for (int i = 0; i < size; i++) {
-        if (context_matches_tiles(&context[i], tiles)) {
-            context[i].current_item_offset++;
-            if (context[i].current_item_offset >= context[i].max_item_offset) {
-                context[i].current_item_offset = 0;
-            }
-            result.is_valid = 1;
-            result.group_offset = context[i].offset_for_orientation[city_view_orientation() / 2];
-            result.item_offset = context[i].current_item_offset;
-            result.aqueduct_offset = context[i].aqueduct_offset;
-            break;
-        }
+    if (!lookup.is_built) {
+        build_lookup();
+    }
+    int pattern = 0;
+    for (int i = 0; i < MAX_TILES; i++) {
+        pattern |= (tiles[i] ? 1 : 0) << i;
+    }
+    int index = lookup.context_for_pattern[group][pattern];
+    if (index == NO_CONTEXT) {
+        result.is_valid = 0;
+        return &result;
+    }
+    struct terrain_image_context *context = &context_pointers[group].context[index];
+    context->current_item_offset++;
+    if (context->current_item_offset >= context->max_item_offset) {
+        context->current_item_offset = 0;
     }
+    result.is_valid = 1;
+    result.group_offset = context->offset_for_orientation[city_view_orientation() / 2];
+    result.item_offset = context->current_item_offset;
+    result.aqueduct_offset = context->aqueduct_offset;
     return &result;
 }
 
@@ -3,10 +3,14 @@
 
 void map_routing_update_all(void);
 void map_routing_update_land(void);
+void map_routing_update_land_area(int x, int y, int size_x, int size_y);
 void map_routing_update_land_citizen(void);
 void map_routing_update_water(void);
 void map_routing_update_walls(void);
 
+unsigned int map_routing_citizen_network_version(void);
+void map_routing_citizen_network_changed(void);
+
 int map_routing_is_wall_passable(int grid_offset);
 int map_routing_wall_tile_in_radius(int x, int y, int radius, int *x_wall, int *y_wall);
 
@@ -5,17 +5,83 @@
 #include "core/image.h"
 #include "map/bridge.h"
 #include "map/building.h"
+#include "map/data.h"
 #include "map/grid.h"
 #include "map/property.h"
 #include "map/ring.h"
 #include "map/routing.h"
 #include "map/sprite.h"
 
+#include <stdlib.h>
 #include <string.h>
 
+#define MAX_TRACKED_TERRAIN_COUNTS 16
+#define MAX_TERRAIN_AREA_TABLES 4
+
 static grid_u32 terrain_grid;
 static grid_u32 terrain_grid_backup;
 
+static struct {
+    unsigned int version;
+    struct {
+        int terrain;
+        int count;
+    } tracked[MAX_TRACKED_TERRAIN_COUNTS];
+    int num_tracked;
+    struct {
+        int terrain;
+        unsigned int version;
+        int width;
+        int height;
+        int *sums;
+    } area_tables[MAX_TERRAIN_AREA_TABLES];
+    int next_area_table;
+} counts;
+
+static int is_inside_map(int grid_offset)
+{
+    int x = grid_offset % GRID_SIZE - map_data.start_offset % GRID_SIZE;
+    int y = grid_offset / GRID_SIZE - map_data.start_offset / GRID_SIZE;
+    return x >= 0 && x < map_data.width && y >= 0 && y < map_data.height;
+}
+
+static void track_change(int grid_offset, unsigned int old_terrain, unsigned int new_terrain)
+{
+    if (old_terrain == new_terrain) {
+        return;
+    }
+    counts.version++;
+    if (!counts.num_tracked || !is_inside_map(grid_offset)) {
+        return;
+    }
+    for (int i = 0; i < counts.num_tracked; i++) {
+        int terrain = counts.tracked[i].terrain;
+        counts.tracked[i].count += ((new_terrain & terrain) != 0) - ((old_terrain & terrain) != 0);
+    }
+}
+
+static int count_tiles_in_map(int terrain)
+{
+    int total = 0;
+    for (int y = 0; y < map_data.height; y++) {
+        int grid_offset = map_data.start_offset + y * GRID_SIZE;
+        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+            if (terrain_grid.items[grid_offset] & terrain) {
+                total++;
+            }
+        }
+    }
+    return total;
+}
+
+static void recount_tracked(void)
+{
+    counts.version++;
+    for (int i = 0; i < counts.num_tracked; i++) {
+        counts.tracked[i].count = count_tiles_in_map(counts.tracked[i].terrain);
+    }
+}
+
 
 const terrain_flags_array *map_terrain_to_array(int grid_offset)
 {
@@ -91,25 +157,137 @@ int map_terrain_get_from_buffer_32(buffer *buf, int grid_offset)
 
 void map_terrain_set(int grid_offset, int terrain)
 {
+    track_change(grid_offset, terrain_grid.items[grid_offset], terrain);
     terrain_grid.items[grid_offset] = terrain;
 }
 
 void map_terrain_add(int grid_offset, int terrain)
 {
+    unsigned int old_terrain = terrain_grid.items[grid_offset];
     terrain_grid.items[grid_offset] |= terrain;
+    track_change(grid_offset, old_terrain, terrain_grid.items[grid_offset]);
 }
 
 void map_terrain_remove(int grid_offset, int terrain)
 {
+    unsigned int old_terrain = terrain_grid.items[grid_offset];
     terrain_grid.items[grid_offset] &= ~terrain;
+    track_change(grid_offset, old_terrain, terrain_grid.items[grid_offset]);
 }
 
 void map_terrain_remove_with_backup(int grid_offset, int terrain)
 {
-    terrain_grid.items[grid_offset] &= ~terrain;
+    map_terrain_remove(grid_offset, terrain);
     terrain_grid_backup.items[grid_offset] &= ~terrain;
 }
 
+unsigned int map_terrain_version(void)
+{
+    return counts.version;
+}
+
+int map_terrain_count_tiles(int terrain)
+{
+    for (int i = 0; i < counts.num_tracked; i++) {
+        if (counts.tracked[i].terrain == terrain) {
+            return counts.tracked[i].count;
+        }
+    }
+    int total = count_tiles_in_map(terrain);
+    if (counts.num_tracked < MAX_TRACKED_TERRAIN_COUNTS) {
+        counts.tracked[counts.num_tracked].terrain = terrain;
+        counts.tracked[counts.num_tracked].count = total;
+        counts.num_tracked++;
+    }
+    return total;
+}
+
+static int build_area_table(int index, int terrain)
+{
+    int width = map_data.width;
+    int height = map_data.height;
+    if (!counts.area_tables[index].sums || counts.area_tables[index].width != width ||
+        counts.area_tables[index].height != height) {
+        int *sums = realloc(counts.area_tables[index].sums, sizeof(int) * (width + 1) * (height + 1));
+        if (!sums) {
+            return 0;
+        }
+        counts.area_tables[index].sums = sums;
+        counts.area_tables[index].width = width;
+        counts.area_tables[index].height = height;
+    }
+    // sums[(y + 1) * (width + 1) + (x + 1)] holds the number of matching tiles in the rectangle (0, 0)-(x, y)
+    int *sums = counts.area_tables[index].sums;
+    memset(sums, 0, sizeof(int) * (width + 1));
+    for (int y = 0; y < height; y++) {
+        int *row = &sums[(y + 1) * (width + 1)];
+        const int *previous_row = row - (width + 1);
+        int grid_offset = map_data.start_offset + y * GRID_SIZE;
+        int row_total = 0;
+        row[0] = 0;
+        for (int x = 0; x < width; x++, grid_offset++) {
+            if (terrain_grid.items[grid_offset] & terrain) {
+                row_total++;
+            }
+            row[x + 1] = previous_row[x + 1] + row_total;
+        }
+    }
+    counts.area_tables[index].terrain = terrain;
+    counts.area_tables[index].version = counts.version;
+    return 1;
+}
+
+static int get_area_table(int terrain)
+{
+    for (int i = 0; i < MAX_TERRAIN_AREA_TABLES; i++) {
+        if (counts.area_tables[i].sums && counts.area_tables[i].terrain == terrain) {
+            if (counts.area_tables[i].version != counts.version ||
+                counts.area_tables[i].width != map_data.width || counts.area_tables[i].height != map_data.height) {
+                return build_area_table(i, terrain) ? i : -1;
+            }
+            return i;
+        }
+    }
+    int index = counts.next_area_table;
+    counts.next_area_table = (counts.next_area_table + 1) % MAX_TERRAIN_AREA_TABLES;
+    return build_area_table(index, terrain) ? index : -1;
+}
+
+int map_terrain_count_tiles_in_area(int terrain, int x_min, int y_min, int x_max, int y_max)
+{
+    if (x_min < 0) {
+        x_min = 0;
+    }
+    if (y_min < 0) {
+        y_min = 0;
+    }
+    if (x_max >= map_data.width) {
+        x_max = map_data.width - 1;
+    }
+    if (y_max >= map_data.height) {
+        y_max = map_data.height - 1;
+    }
+    if (x_min > x_max || y_min > y_max) {
+        return 0;
+    }
+    int index = get_area_table(terrain);
+    if (index < 0) {
+        int total = 0;
+        for (int y = y_min; y <= y_max; y++) {
+            for (int x = x_min; x <= x_max; x++) {
+                if (terrain_grid.items[map_grid_offset(x, y)] & terrain) {
+                    total++;
+                }
+            }
+        }
+        return total;
+    }
+    const int *sums = counts.area_tables[index].sums;
+    int stride = counts.area_tables[index].width + 1;
+    return sums[(y_max + 1) * stride + x_max + 1] - sums[y_min * stride + x_max + 1]
+        - sums[(y_max + 1) * stride + x_min] + sums[y_min * stride + x_min];
+}
+
 void map_terrain_add_with_radius(int x, int y, int size, int radius, int terrain)
 {
     int x_min, y_min, x_max, y_max;
@@ -137,6 +315,7 @@ void map_terrain_remove_with_radius(int x, int y, int size, int radius, int terr
 void map_terrain_remove_all(int terrain)
 {
     map_grid_and_u32(terrain_grid.items, ~terrain);
+    recount_tracked();
 }
 
 unsigned int map_terrain_count_directly_adjacent_with_type(int grid_offset, int terrain)
@@ -472,12 +651,19 @@ void map_terrain_backup(void)
 
 void map_terrain_restore(void)
 {
-    map_grid_copy_u32(terrain_grid_backup.items, terrain_grid.items);
+    // Restoring happens on every construction preview update, so only the tiles that actually differ are tracked
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        if (terrain_grid.items[i] != terrain_grid_backup.items[i]) {
+            track_change(i, terrain_grid.items[i], terrain_grid_backup.items[i]);
+            terrain_grid.items[i] = terrain_grid_backup.items[i];
+        }
+    }
 }
 
 void map_terrain_clear(void)
 {
     map_grid_clear_u32(terrain_grid.items);
+    recount_tracked();
 }
 
 void map_terrain_init_outside_map(void)
@@ -494,6 +680,7 @@ void map_terrain_init_outside_map(void)
             }
         }
     }
+    recount_tracked();
 }
 
 void map_terrain_save_state(buffer *buf)
@@ -681,4 +868,5 @@ void map_terrain_load_state(buffer *buf, int expanded_terrain_data, buffer *imag
         map_grid_load_state_u16_to_u32(terrain_grid.items, buf);
     }
     determine_original_trees(images, legacy_image_buffer);
+    recount_tracked();
 }
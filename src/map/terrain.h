@@ -105,6 +105,28 @@ void map_terrain_remove_with_radius(int x, int y, int size, int radius, int terr
 
 void map_terrain_remove_all(int terrain);
 
+/**
+ * Returns a number that changes whenever any tile's terrain changes.
+ */
+unsigned int map_terrain_version(void);
+
+/**
+ * Counts the tiles inside the map that match any bit of the terrain bitmask.
+ * The count is kept up to date on every terrain change once a bitmask has been queried.
+ * @param terrain Terrain bitmask to be checked for.
+ * @return The number of matching tiles.
+ */
+int map_terrain_count_tiles(int terrain);
+
+/**
+ * Counts the tiles in a rectangle that match any bit of the terrain bitmask, using a summed-area table
+ * that is only rebuilt after the terrain changed.
+ * @param terrain Terrain bitmask to be checked for.
+ * @param x_min, y_min, x_max, y_max Inclusive rectangle corners, in map coordinates.
+ * @return The number of matching tiles.
+ */
+int map_terrain_count_tiles_in_area(int terrain, int x_min, int y_min, int x_max, int y_max);
+
 /**
  * Check orthogonal neighbours of a tile if they contain a terrain.
  * @param grid_offset Tile which neighbours will be checked.
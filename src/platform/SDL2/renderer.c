@@ -37,6 +37,11 @@
 #define HAS_TEXTURE_SCALE_MODE 0
 #endif
 
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+#define USE_RENDER_GEOMETRY
+#define HAS_RENDER_GEOMETRY (platform_sdl_version_at_least(2, 0, 18))
+#endif
+
 #define MAX_UNPACKED_IMAGES 20
 
 #define MAX_PACKED_IMAGE_SIZE 64000
@@ -93,6 +98,11 @@ static struct {
         int height;
         int opacity;
     } tooltip;
+    struct {
+        SDL_Texture *texture;
+        int width;
+        int height;
+    } offscreen;
     SDL_Texture **texture_lists[ATLAS_MAX];
     image_atlas_data atlas_data[ATLAS_MAX];
     struct {
@@ -115,6 +125,13 @@ static struct {
         time_millis last_used;
         SDL_Texture *texture;
     } unpacked_images[MAX_UNPACKED_IMAGES];
+#ifdef USE_RENDER_GEOMETRY
+    struct {
+        SDL_Vertex *vertices;
+        int *indices;
+        int capacity;
+    } line_geometry;
+#endif
     graphics_renderer_interface renderer_interface;
     int supports_yuv_textures;
     float city_scale;
@@ -144,6 +161,99 @@ static void draw_line(int x_start, int x_end, int y_start, int y_end, color_t co
         (color & COLOR_CHANNEL_ALPHA) >> COLOR_BITSHIFT_ALPHA);
     SDL_RenderDrawLine(data.renderer, x_start, y_start, x_end, y_end);
 }
+#ifdef USE_RENDER_GEOMETRY
+
+static int reserve_line_geometry(int count)
+{
+    if (count <= data.line_geometry.capacity) {
+        return 1;
+    }
+    SDL_Vertex *vertices = realloc(data.line_geometry.vertices, sizeof(SDL_Vertex) * 4 * count);
+    if (!vertices) {
+        return 0;
+    }
+    data.line_geometry.vertices = vertices;
+    int *indices = realloc(data.line_geometry.indices, sizeof(int) * 6 * count);
+    if (!indices) {
+        return 0;
+    }
+    data.line_geometry.indices = indices;
+    data.line_geometry.capacity = count;
+    return 1;
+}
+
+// Turns each segment into a one pixel wide quad covering the same pixels as the line,
+// so all of them can be submitted with a single geometry call
+static void add_line_quad(const line_segment *line, int index, SDL_Color color)
+{
+    float dx = (float) (line->x_end - line->x_start);
+    float dy = (float) (line->y_end - line->y_start);
+    float length = sqrtf(dx * dx + dy * dy);
+    float ux = 1.0f;
+    float uy = 0.0f;
+    if (length > 0.0f) {
+        ux = dx / length;
+        uy = dy / length;
+    }
+    float nx = -uy * 0.5f;
+    float ny = ux * 0.5f;
+    float x_start = line->x_start + 0.5f - ux * 0.5f;
+    float y_start = line->y_start + 0.5f - uy * 0.5f;
+    float x_end = line->x_end + 0.5f + ux * 0.5f;
+    float y_end = line->y_end + 0.5f + uy * 0.5f;
+
+    SDL_Vertex *v = &data.line_geometry.vertices[index * 4];
+    v[0].position.x = x_start + nx;
+    v[0].position.y = y_start + ny;
+    v[1].position.x = x_start - nx;
+    v[1].position.y = y_start - ny;
+    v[2].position.x = x_end - nx;
+    v[2].position.y = y_end - ny;
+    v[3].position.x = x_end + nx;
+    v[3].position.y = y_end + ny;
+    for (int i = 0; i < 4; i++) {
+        v[i].color = color;
+        v[i].tex_coord.x = 0.0f;
+        v[i].tex_coord.y = 0.0f;
+    }
+
+    int *indices = &data.line_geometry.indices[index * 6];
+    int first = index * 4;
+    indices[0] = first;
+    indices[1] = first + 1;
+    indices[2] = first + 2;
+    indices[3] = first;
+    indices[4] = first + 2;
+    indices[5] = first + 3;
+}
+#endif
+
+static void draw_lines(const line_segment *lines, int count, color_t color)
+{
+    if (data.paused || count <= 0) {
+        return;
+    }
+    SDL_Color sdl_color = {
+        (color & COLOR_CHANNEL_RED) >> COLOR_BITSHIFT_RED,
+        (color & COLOR_CHANNEL_GREEN) >> COLOR_BITSHIFT_GREEN,
+        (color & COLOR_CHANNEL_BLUE) >> COLOR_BITSHIFT_BLUE,
+        (color & COLOR_CHANNEL_ALPHA) >> COLOR_BITSHIFT_ALPHA
+    };
+#ifdef USE_RENDER_GEOMETRY
+    if (HAS_RENDER_GEOMETRY && reserve_line_geometry(count)) {
+        for (int i = 0; i < count; i++) {
+            add_line_quad(&lines[i], i, sdl_color);
+        }
+        SDL_RenderGeometry(data.renderer, 0, data.line_geometry.vertices, count * 4,
+            data.line_geometry.indices, count * 6);
+        return;
+    }
+#endif
+    SDL_SetRenderDrawColor(data.renderer, sdl_color.r, sdl_color.g, sdl_color.b, sdl_color.a);
+    for (int i = 0; i < count; i++) {
+        SDL_RenderDrawLine(data.renderer, lines[i].x_start, lines[i].y_start, lines[i].x_end, lines[i].y_end);
+    }
+}
 
 static void draw_rect(int x_start, int x_end, int y_start, int y_end, color_t color)
 {
@@ -416,6 +526,16 @@ static const image_atlas_data *get_texture_atlas(atlas_type type)
     return &data.atlas_data[type];
 }
 
+static void destroy_offscreen_texture(void)
+{
+    if (data.offscreen.texture) {
+        SDL_DestroyTexture(data.offscreen.texture);
+        data.offscreen.texture = 0;
+    }
+    data.offscreen.width = 0;
+    data.offscreen.height = 0;
+}
+
 static void free_all_textures(void)
 {
     for (atlas_type i = ATLAS_FIRST; i < ATLAS_MAX - 1; i++) {
@@ -434,6 +554,7 @@ static void free_all_textures(void)
     }
 
     free_silhouettes();
+    destroy_offscreen_texture();
 
     if (data.tooltip.texture) {
         SDL_DestroyTexture(data.tooltip.texture);
@@ -734,6 +855,37 @@ static void finish_tooltip_creation(void)
     SDL_SetRenderTarget(data.renderer, data.render_texture);
 }
 
+static int start_offscreen_rendering(int width, int height)
+{
+    if (data.paused || width > data.max_texture_size.width || height > data.max_texture_size.height) {
+        return 0;
+    }
+    if (data.offscreen.texture && (data.offscreen.width < width || data.offscreen.height < height)) {
+        destroy_offscreen_texture();
+    }
+    if (!data.offscreen.texture) {
+        data.offscreen.texture = SDL_CreateTexture(data.renderer, SDL_PIXELFORMAT_ARGB8888,
+            SDL_TEXTUREACCESS_TARGET, width, height);
+        if (!data.offscreen.texture) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unable to create offscreen texture: %s", SDL_GetError());
+            return 0;
+        }
+        data.offscreen.width = width;
+        data.offscreen.height = height;
+    }
+    return SDL_SetRenderTarget(data.renderer, data.offscreen.texture) == 0;
+}
+
+static void finish_offscreen_rendering(void)
+{
+    if (data.paused) {
+        return;
+    }
+    SDL_SetRenderTarget(data.renderer, data.render_texture);
+    // Offscreen targets are usually very large, so don't keep them around
+    destroy_offscreen_texture();
+}
+
 static int has_tooltip(void)
 {
     return data.tooltip.texture != 0;
@@ -1152,6 +1304,7 @@ static void create_renderer_interface(void)
     data.renderer_interface.set_clip_rectangle = set_clip_rectangle;
     data.renderer_interface.reset_clip_rectangle = reset_clip_rectangle;
     data.renderer_interface.draw_line = draw_line;
+    data.renderer_interface.draw_lines = draw_lines;
     data.renderer_interface.draw_rect = draw_rect;
     data.renderer_interface.fill_rect = fill_rect;
     data.renderer_interface.draw_image = draw_texture;
@@ -1171,6 +1324,8 @@ static void create_renderer_interface(void)
     data.renderer_interface.set_tooltip_position = set_tooltip_position;
     data.renderer_interface.set_tooltip_opacity = set_tooltip_opacity;
     data.renderer_interface.has_tooltip = has_tooltip;
+    data.renderer_interface.start_offscreen_rendering = start_offscreen_rendering;
+    data.renderer_interface.finish_offscreen_rendering = finish_offscreen_rendering;
     data.renderer_interface.save_image_from_screen = save_to_texture;
     data.renderer_interface.draw_image_to_screen = draw_saved_texture;
     data.renderer_interface.save_screen_buffer = save_screen_buffer;
@@ -1325,6 +1480,7 @@ int platform_renderer_lost_render_texture(void)
 
 void platform_renderer_invalidate_target_textures(void)
 {
+    graphics_renderer_targets_reset();
     if (data.custom_textures[CUSTOM_IMAGE_RED_FOOTPRINT].texture) {
         SDL_DestroyTexture(data.custom_textures[CUSTOM_IMAGE_RED_FOOTPRINT].texture);
         data.custom_textures[CUSTOM_IMAGE_RED_FOOTPRINT].texture = 0;
@@ -0,0 +1,76 @@
+#include "platform/thread.h"
+
+#include <SDL3/SDL.h>
+
+platform_thread *platform_thread_create(int (*function)(void *userdata), const char *name, void *userdata)
+{
+    SDL_Thread *thread = SDL_CreateThread(function, name, userdata);
+    if (!thread) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "Unable to create thread %s: %s", name, SDL_GetError());
+    }
+    return (platform_thread *) thread;
+}
+
+int platform_thread_wait(platform_thread *thread)
+{
+    int status = 0;
+    if (thread) {
+        SDL_WaitThread((SDL_Thread *) thread, &status);
+    }
+    return status;
+}
+
+int platform_thread_cpu_count(void)
+{
+    int count = SDL_GetNumLogicalCPUCores();
+    return count > 0 ? count : 1;
+}
+
+platform_mutex *platform_mutex_create(void)
+{
+    return (platform_mutex *) SDL_CreateMutex();
+}
+
+void platform_mutex_destroy(platform_mutex *mutex)
+{
+    if (mutex) {
+        SDL_DestroyMutex((SDL_Mutex *) mutex);
+    }
+}
+
+void platform_mutex_lock(platform_mutex *mutex)
+{
+    SDL_LockMutex((SDL_Mutex *) mutex);
+}
+
+void platform_mutex_unlock(platform_mutex *mutex)
+{
+    SDL_UnlockMutex((SDL_Mutex *) mutex);
+}
+
+platform_condition *platform_condition_create(void)
+{
+    return (platform_condition *) SDL_CreateCondition();
+}
+
+void platform_condition_destroy(platform_condition *condition)
+{
+    if (condition) {
+        SDL_DestroyCondition((SDL_Condition *) condition);
+    }
+}
+
+void platform_condition_wait(platform_condition *condition, platform_mutex *mutex)
+{
+    SDL_WaitCondition((SDL_Condition *) condition, (SDL_Mutex *) mutex);
+}
+
+void platform_condition_signal(platform_condition *condition)
+{
+    SDL_SignalCondition((SDL_Condition *) condition);
+}
+
+void platform_condition_broadcast(platform_condition *condition)
+{
+    SDL_BroadcastCondition((SDL_Condition *) condition);
+}
@@ -0,0 +1,50 @@
+#ifndef PLATFORM_THREAD_H
+#define PLATFORM_THREAD_H
+
+/**
+ * @file
+ * Minimal threading primitives backed by the SDL version in use.
+ *
+ * Threads may not be available on every platform (e.g. emscripten builds without pthreads),
+ * so callers must always be prepared for platform_thread_create to fail and fall back
+ * to doing the work on the calling thread.
+ */
+
+typedef struct platform_thread platform_thread;
+typedef struct platform_mutex platform_mutex;
+typedef struct platform_condition platform_condition;
+
+/**
+ * Starts a new thread
+ * @param function The function to run
+ * @param name The thread name, used for debugging
+ * @param userdata Data passed to the function
+ * @return The thread, or 0 if threads are not available
+ */
+platform_thread *platform_thread_create(int (*function)(void *userdata), const char *name, void *userdata);
+
+/**
+ * Waits for a thread to finish and releases it
+ * @param thread The thread to wait for
+ * @return The value returned by the thread function
+ */
+int platform_thread_wait(platform_thread *thread);
+
+/**
+ * Gets the number of logical CPU cores
+ * @return The number of cores, at least 1
+ */
+int platform_thread_cpu_count(void);
+
+platform_mutex *platform_mutex_create(void);
+void platform_mutex_destroy(platform_mutex *mutex);
+void platform_mutex_lock(platform_mutex *mutex);
+void platform_mutex_unlock(platform_mutex *mutex);
+
+platform_condition *platform_condition_create(void);
+void platform_condition_destroy(platform_condition *condition);
+void platform_condition_wait(platform_condition *condition, platform_mutex *mutex);
+void platform_condition_signal(platform_condition *condition);
+void platform_condition_broadcast(platform_condition *condition);
+
+#endif // PLATFORM_THREAD_H
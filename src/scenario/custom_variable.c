@@ -21,6 +21,7 @@ typedef struct {
 } custom_variable_t;
 
 static array(custom_variable_t) custom_variables;
+static unsigned int values_version;
 static custom_variable_t *get_variable(unsigned int id);
 
 #define CUSTOM_VARIABLES_SIZE_STEP 8
@@ -44,6 +45,7 @@ unsigned int scenario_custom_variable_create(const uint8_t *name, int initial_va
     }
     variable->in_use = 1;
     variable->value = initial_value;
+    values_version++;
     variable->text_display[0] = 0; // Initialize to empty string
     variable->allow_display = 0; // Initialize to not visible
     if (name) {
@@ -57,6 +59,7 @@ void scenario_custom_variable_delete_all(void)
 {
     array_init(custom_variables, CUSTOM_VARIABLES_SIZE_STEP, new_variable, variable_in_use);
     array_advance(custom_variables);
+    values_version++;
 }
 
 void scenario_custom_variable_set_color_group(unsigned int id, int color_group)
@@ -129,6 +132,7 @@ void scenario_custom_variable_delete(unsigned int id)
     custom_variable_t *variable = get_variable(id);
     if (variable) {
         variable->in_use = 0;
+        values_version++;
     }
 }
 
@@ -194,7 +198,15 @@ void scenario_custom_variable_set_value(unsigned int id, int new_value)
     if (!variable) {
         return;
     }
-    variable->value = new_value;
+    if (variable->value != new_value) {
+        variable->value = new_value;
+        values_version++;
+    }
+}
+
+unsigned int scenario_custom_variable_version(void)
+{
+    return values_version;
 }
 
 void scenario_custom_variable_save_state(buffer *buf)
@@ -223,6 +235,7 @@ void scenario_custom_variable_save_state(buffer *buf)
 void scenario_custom_variable_load_state(buffer *buf, int version)
 {
     size_t total_variables = buffer_load_dynamic_array(buf);
+    values_version++;
 
     if (!array_init(custom_variables, CUSTOM_VARIABLES_SIZE_STEP, new_variable, variable_in_use) ||
         !array_expand(custom_variables, (unsigned int) total_variables)) {
@@ -254,6 +267,7 @@ void scenario_custom_variable_load_state(buffer *buf, int version)
 
 void scenario_custom_variable_load_state_old_version(buffer *buf)
 {
+    values_version++;
     if (!array_init(custom_variables, CUSTOM_VARIABLES_SIZE_STEP, new_variable, variable_in_use) ||
         !array_expand(custom_variables, MAX_ORIGINAL_CUSTOM_VARIABLES)) {
         log_error("Failed to initialize custom variables array - out of memory. The game will probably crash.", 0, 0);
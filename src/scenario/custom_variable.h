@@ -32,6 +32,7 @@ void scenario_custom_variable_set_text_display(unsigned int id, const uint8_t *t
 
 int scenario_custom_variable_get_value(unsigned int id);
 void scenario_custom_variable_set_value(unsigned int id, int new_value);
+unsigned int scenario_custom_variable_version(void);
 
 void scenario_custom_variable_save_state(buffer *buf);
 void scenario_custom_variable_load_state(buffer *buf, int version);
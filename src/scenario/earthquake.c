@@ -116,7 +116,7 @@ static void advance_earthquake_to_tile(int x, int y)
         sound_effect_play(SOUND_EFFECT_EXPLOSION);
         int ruin_id = map_building_at(grid_offset);
         if (ruin_id) {
-            building_get(ruin_id)->state = BUILDING_STATE_DELETED_BY_GAME;
+            building_set_state(building_get(ruin_id), BUILDING_STATE_DELETED_BY_GAME);
             map_building_set(grid_offset, 0);
         }
     }
@@ -3,6 +3,7 @@
 #include "core/log.h"
 #include "game/resource.h"
 #include "scenario/event/condition_types.h"
+#include "scenario/event/controller.h"
 
 static int condition_in_use(const scenario_condition_t *condition)
 {
@@ -172,3 +173,24 @@ int scenario_condition_uses_custom_variable(const scenario_condition_t *conditio
             return 0;
     }
 }
+
+unsigned int scenario_condition_get_inputs(const scenario_condition_t *condition)
+{
+    switch (condition->type) {
+        case CONDITION_TYPE_UNDEFINED:
+            return 0;
+        case CONDITION_TYPE_TIME_PASSED:
+            return EVENT_INPUT_FLAG(EVENT_INPUT_MONTH);
+        case CONDITION_TYPE_DIFFICULTY:
+            return EVENT_INPUT_FLAG(EVENT_INPUT_DIFFICULTY);
+        case CONDITION_TYPE_CUSTOM_VARIABLE_CHECK:
+            return EVENT_INPUT_FLAG(EVENT_INPUT_CUSTOM_VARIABLES) | scenario_formula_get_inputs(condition->parameter3);
+        case CONDITION_TYPE_CHECK_FORMULA:
+            return scenario_formula_get_inputs(condition->parameter1) |
+                scenario_formula_get_inputs(condition->parameter3);
+        case CONDITION_TYPE_TERRAIN_IN_AREA:
+            return EVENT_INPUT_FLAG(EVENT_INPUT_TERRAIN) | scenario_formula_get_inputs(condition->parameter5);
+        default:
+            return EVENT_INPUT_FLAG(EVENT_INPUT_EVERY_DAY);
+    }
+}
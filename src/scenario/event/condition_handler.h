@@ -18,4 +18,10 @@ void scenario_condition_group_load_state(buffer *buf, scenario_condition_group_t
     int *link_type, int32_t *link_id);
 int scenario_condition_uses_custom_variable(const scenario_condition_t *condition, int custom_variable_id);
 
+/**
+ * Returns the inputs a condition reads, as EVENT_INPUT_FLAG bits.
+ * A condition only has to be evaluated again when one of its inputs changed.
+ */
+unsigned int scenario_condition_get_inputs(const scenario_condition_t *condition);
+
 #endif // CONDITION_HANDLER_H
@@ -27,11 +27,6 @@
 
 #define BUILDING_RUBBLE -1
 
-static int count_no_condition(int grid_offset)
-{
-    return 1;
-}
-
 static int count_not_overgrown(int grid_offset)
 {
     return !map_property_is_plaza_earthquake_or_overgrown_garden(grid_offset);
@@ -76,10 +71,10 @@ int scenario_condition_type_building_count_active_met(const scenario_condition_t
             total_active_count = building_count_any_total(1);
             break;
         case BUILDING_ROAD:
-            total_active_count = building_count_terrain(TERRAIN_ROAD, count_no_condition);
+            total_active_count = building_count_terrain(TERRAIN_ROAD, NULL);
             break;
         case BUILDING_HIGHWAY:
-            total_active_count = building_count_terrain(TERRAIN_HIGHWAY, count_no_condition);
+            total_active_count = building_count_terrain(TERRAIN_HIGHWAY, NULL);
             break;
         case BUILDING_PLAZA:
             total_active_count = building_count_terrain(TERRAIN_ROAD, map_property_is_plaza_earthquake_or_overgrown_garden);
@@ -91,7 +86,7 @@ int scenario_condition_type_building_count_active_met(const scenario_condition_t
             total_active_count = building_count_terrain(TERRAIN_GARDEN, map_property_is_plaza_earthquake_or_overgrown_garden);
             break;
         case BUILDING_RUBBLE:
-            total_active_count = building_count_terrain(TERRAIN_RUBBLE, count_no_condition);
+            total_active_count = building_count_terrain(TERRAIN_RUBBLE, NULL);
             break;
         case BUILDING_LOW_BRIDGE:
             total_active_count = building_count_bridges(0);
@@ -146,10 +141,10 @@ int scenario_condition_type_building_count_any_met(const scenario_condition_t *c
             total_active_count = building_count_any_total(0);
             break;
         case BUILDING_ROAD:
-            total_active_count = building_count_terrain(TERRAIN_ROAD, count_no_condition);
+            total_active_count = building_count_terrain(TERRAIN_ROAD, NULL);
             break;
         case BUILDING_HIGHWAY:
-            total_active_count = building_count_terrain(TERRAIN_HIGHWAY, count_no_condition);
+            total_active_count = building_count_terrain(TERRAIN_HIGHWAY, NULL);
             break;
         case BUILDING_PLAZA:
             total_active_count = building_count_terrain(TERRAIN_ROAD, map_property_is_plaza_earthquake_or_overgrown_garden);
@@ -161,7 +156,7 @@ int scenario_condition_type_building_count_any_met(const scenario_condition_t *c
             total_active_count = building_count_terrain(TERRAIN_GARDEN, map_property_is_plaza_earthquake_or_overgrown_garden);
             break;
         case BUILDING_RUBBLE:
-            total_active_count = building_count_terrain(TERRAIN_RUBBLE, count_no_condition);
+            total_active_count = building_count_terrain(TERRAIN_RUBBLE, NULL);
             break;
         case BUILDING_LOW_BRIDGE:
             total_active_count = building_count_bridges(0);
@@ -196,14 +191,12 @@ int scenario_condition_type_terrain_count_area_met(const scenario_condition_t *c
     int comparison = condition->parameter4;
     int value = scenario_formula_evaluate_formula(condition->parameter5);
 
-    int current_count = 0;
-    grid_slice *slice = map_grid_get_grid_slice_from_corner_offsets(grid_offset1, grid_offset2);
-    for (int i = 0; i < slice->size; i++) {
-        int grid_offset = slice->grid_offsets[i];
-        if (map_terrain_is(grid_offset, terrain_type)) {
-            current_count++;
-        }
-    }
+    int x1 = map_grid_offset_to_x(grid_offset1);
+    int y1 = map_grid_offset_to_y(grid_offset1);
+    int x2 = map_grid_offset_to_x(grid_offset2);
+    int y2 = map_grid_offset_to_y(grid_offset2);
+    int current_count = map_terrain_count_tiles_in_area(terrain_type,
+        x1 < x2 ? x1 : x2, y1 < y2 ? y1 : y2, x1 > x2 ? x1 : x2, y1 > y2 ? y1 : y2);
     return comparison_helper_compare_values(comparison, current_count, value);
 }
 
@@ -250,11 +243,11 @@ int scenario_condition_type_building_count_area_met(const scenario_condition_t *
             break;
         case BUILDING_ROAD:
             buildings_in_area = building_count_terrain_in_area(minx, miny, maxx + 1, maxy + 1,
-                TERRAIN_ROAD, count_no_condition);
+                TERRAIN_ROAD, NULL);
             break;
         case BUILDING_HIGHWAY:
             buildings_in_area = building_count_terrain_in_area(minx, miny, maxx + 1, maxy + 1,
-                TERRAIN_HIGHWAY, count_no_condition);
+                TERRAIN_HIGHWAY, NULL);
             break;
         case BUILDING_PLAZA:
             buildings_in_area = building_count_terrain_in_area(minx, miny, maxx + 1, maxy + 1,
@@ -270,7 +263,7 @@ int scenario_condition_type_building_count_area_met(const scenario_condition_t *
             break;
         case BUILDING_RUBBLE:
             buildings_in_area = building_count_terrain_in_area(minx, miny, maxx + 1, maxy + 1,
-                TERRAIN_RUBBLE, count_no_condition);
+                TERRAIN_RUBBLE, NULL);
             break;
         case BUILDING_LOW_BRIDGE:
             buildings_in_area = building_count_bridges_in_area(minx, miny, maxx + 1, maxy + 1, 0);
@@ -73,6 +73,10 @@ void scenario_formula_change(unsigned int id, const uint8_t *formatted_calculati
         formula->is_error = 1;
         formula->is_static = 0;
     }
+    scenario_event_t *current;
+    array_foreach(scenario_events, current) {
+        current->needs_evaluation = 1;
+    }
 }
 
 const uint8_t *scenario_formula_get_string(unsigned int id)
@@ -101,6 +105,22 @@ scenario_formula_t *scenario_formula_get(unsigned int id)
     return array_item(scenario_formulas, id);
 }
 
+unsigned int scenario_formula_get_inputs(unsigned int id)
+{
+    if (id == 0 || id >= scenario_formulas.size) {
+        return 0;
+    }
+    const scenario_formula_t *formula = array_item(scenario_formulas, id);
+    if (formula->is_error || formula->is_static) {
+        return 0;
+    }
+    // Random ranges are rolled again on every evaluation
+    if (strchr((const char *) formula->formatted_calculation, ',')) {
+        return EVENT_INPUT_FLAG(EVENT_INPUT_EVERY_DAY);
+    }
+    return EVENT_INPUT_FLAG(EVENT_INPUT_CUSTOM_VARIABLES);
+}
+
 int scenario_formula_evaluate_formula(unsigned int id)
 {
     if (id == 0 || id >= scenario_formulas.size) {
@@ -16,6 +16,7 @@ void scenario_formula_change(unsigned int id, const uint8_t *formatted_calculati
 const uint8_t *scenario_formula_get_string(unsigned int id);
 scenario_formula_t *scenario_formula_get(unsigned int id);
 int scenario_formula_evaluate_formula(unsigned int id);
+unsigned int scenario_formula_get_inputs(unsigned int id);
 
 void scenario_events_init(void);
 
@@ -19,6 +19,17 @@ typedef enum {
     EVENT_STATE_DELETED = 4
 } event_state;
 
+typedef enum {
+    EVENT_INPUT_MONTH = 0,
+    EVENT_INPUT_CUSTOM_VARIABLES = 1,
+    EVENT_INPUT_TERRAIN = 2,
+    EVENT_INPUT_DIFFICULTY = 3,
+    EVENT_INPUT_EVERY_DAY = 4, // city state and random formulas, which can change on any day
+    EVENT_INPUT_MAX
+} event_input;
+
+#define EVENT_INPUT_FLAG(input) (1u << (input))
+
 typedef enum {
     FULFILLMENT_TYPE_ALL = 0,
     FULFILLMENT_TYPE_ANY = 1
@@ -169,6 +180,9 @@ typedef struct {
     uint8_t name[EVENT_NAME_LENGTH];
     array(scenario_condition_group_t) condition_groups;
     array(scenario_action_t) actions;
+    unsigned int inputs; // not saved, EVENT_INPUT_FLAG bits of everything the conditions read
+    unsigned int input_versions[EVENT_INPUT_MAX]; // not saved, input versions at the last evaluation
+    uint8_t needs_evaluation; // not saved, set whenever the event or its conditions are reset
 } scenario_event_t;
 
 typedef struct {
@@ -4,6 +4,10 @@
 #include "core/log.h"
 #include "core/random.h"
 #include "game/save_version.h"
+#include "game/settings.h"
+#include "game/time.h"
+#include "map/terrain.h"
+#include "scenario/custom_variable.h"
 #include "scenario/event/action_handler.h"
 #include "scenario/event/condition_handler.h"
 
@@ -19,6 +23,7 @@ static int action_in_use(const scenario_action_t *action)
 void scenario_event_new(scenario_event_t *event, unsigned int position)
 {
     event->id = position;
+    event->needs_evaluation = 1;
     if (!array_init(event->actions, SCENARIO_ACTIONS_ARRAY_SIZE_STEP, 0, action_in_use) ||
         !array_init(event->condition_groups, SCENARIO_CONDITION_GROUPS_ARRAY_SIZE_STEP,
             scenario_condition_group_new, scenario_condition_group_in_use)) {
@@ -34,6 +39,7 @@ int scenario_event_is_active(const scenario_event_t *event)
 void scenario_event_init(scenario_event_t *event)
 {
     event->state = EVENT_STATE_ACTIVE;
+    event->needs_evaluation = 1;
     unsigned int event_id = event->id;
     scenario_condition_group_t *group;
     scenario_condition_t *condition;
@@ -72,6 +78,7 @@ void scenario_event_load_state(buffer *buf, scenario_event_t *event, int scenari
 {
     int saved_id = buffer_read_i32(buf);
     event->state = buffer_read_i16(buf);
+    event->needs_evaluation = 1;
     event->repeat_days_min = buffer_read_i32(buf);
     event->repeat_days_max = buffer_read_i32(buf);
     if (scenario_version <= SCENARIO_LAST_NO_FORMULAS_AND_MODEL_DATA) {
@@ -132,6 +139,7 @@ void scenario_event_link_condition_group(scenario_event_t *event, scenario_condi
     scenario_condition_group_t *new_group = 0;
     array_new_item(event->condition_groups, new_group);
     new_group->conditions = group->conditions;
+    event->needs_evaluation = 1;
     scenario_condition_t *condition;
     array_foreach(new_group->conditions, condition)
     {
@@ -215,6 +223,7 @@ int scenario_event_decrease_pause_time(scenario_event_t *event, int days_passed)
     }
     if (event->days_until_active == 0) {
         event->state = EVENT_STATE_ACTIVE;
+        event->needs_evaluation = 1;
     }
     return 1;
 }
@@ -229,8 +238,61 @@ int scenario_event_count_conditions(const scenario_event_t *event)
     return total_conditions;
 }
 
+static unsigned int get_input_version(event_input input)
+{
+    switch (input) {
+        case EVENT_INPUT_MONTH:
+            return game_time_total_months();
+        case EVENT_INPUT_CUSTOM_VARIABLES:
+            return scenario_custom_variable_version();
+        case EVENT_INPUT_TERRAIN:
+            return map_terrain_version();
+        case EVENT_INPUT_DIFFICULTY:
+            return setting_difficulty();
+        default:
+            return 0;
+    }
+}
+
+static unsigned int get_event_inputs(const scenario_event_t *event)
+{
+    unsigned int inputs = 0;
+    const scenario_condition_group_t *group;
+    array_foreach(event->condition_groups, group) {
+        for (unsigned int i = 0; i < group->conditions.size; i++) {
+            inputs |= scenario_condition_get_inputs(array_item(group->conditions, i));
+        }
+    }
+    return inputs;
+}
+
+static int inputs_changed(scenario_event_t *event)
+{
+    int changed = 0;
+    if (event->needs_evaluation) {
+        event->inputs = get_event_inputs(event);
+        event->needs_evaluation = 0;
+        changed = 1;
+    }
+    for (event_input input = 0; input < EVENT_INPUT_EVERY_DAY; input++) {
+        if (!(event->inputs & EVENT_INPUT_FLAG(input))) {
+            continue;
+        }
+        unsigned int version = get_input_version(input);
+        if (event->input_versions[input] != version) {
+            event->input_versions[input] = version;
+            changed = 1;
+        }
+    }
+    return changed || (event->inputs & EVENT_INPUT_FLAG(EVENT_INPUT_EVERY_DAY));
+}
+
 int scenario_event_conditional_execute(scenario_event_t *event)
 {
+    // Conditions only need to be checked again when something they read has changed since the last check
+    if (event->state != EVENT_STATE_ACTIVE || !inputs_changed(event)) {
+        return 0;
+    }
     if (conditions_fulfilled(event)) {
         int result = scenario_event_execute(event);
         event->execution_count++;
@@ -161,11 +161,6 @@ static int population_by_age(scenario_action_t *action)
     return is_absolute ? value : calc_percentage(value, total_pop);
 }
 
-static int count_no_condition(int grid_offset)
-{
-    return 1;
-}
-
 static int count_not_overgrown(int grid_offset)
 {
     return !map_property_is_plaza_earthquake_or_overgrown_garden(grid_offset);
@@ -208,10 +203,10 @@ static int get_building_count(scenario_action_t *action)
             total_count = building_count_any_total(active_only);
             break;
         case BUILDING_ROAD:
-            total_count = building_count_terrain(TERRAIN_ROAD, count_no_condition);
+            total_count = building_count_terrain(TERRAIN_ROAD, NULL);
             break;
         case BUILDING_HIGHWAY:
-            total_count = building_count_terrain(TERRAIN_HIGHWAY, count_no_condition);
+            total_count = building_count_terrain(TERRAIN_HIGHWAY, NULL);
             break;
         case BUILDING_PLAZA:
             total_count = building_count_terrain(TERRAIN_ROAD, map_property_is_plaza_earthquake_or_overgrown_garden);
@@ -243,35 +238,13 @@ static int get_player_soldiers_count(scenario_action_t *action)
 
 static int get_enemy_troops_count(scenario_action_t *action)
 {
-    enemy_class_t enemy_class = action->parameter3;
-    int count = 0;
-    for (unsigned int i = 1; i < figure_count(); i++) {    // Iterate through all figures to count enemy troops
-        figure *f = figure_get(i);
-        if (!figure_is_enemy(f) || figure_is_dead(f)) {
-            continue;
-        }
-        switch (enemy_class) {
-            case ENEMY_CLASS_MELEE:
-                count += figure_is_melee_enemy(f);
-                break;
-            case ENEMY_CLASS_RANGED:
-                count += figure_is_ranged_enemy(f);
-                break;
-            case ENEMY_CLASS_MOUNTED:
-                count += figure_is_mounted_enemy(f);
-                break;
-            case ENEMY_CLASS_ALL:
-                count++;
-                break;
-        }
-    }
-    return count;
+    return figure_count_enemies(action->parameter3);
 }
 
 static int get_terrain_tiles_count(scenario_action_t *action)
 {
     int terrain_type = action->parameter3;
-    return building_count_terrain(terrain_type, count_no_condition);
+    return building_count_terrain(terrain_type, NULL);
 }
 
 static int city_trade_quota_fill_percentage(scenario_action_t *action)
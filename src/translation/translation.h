@@ -2111,6 +2111,8 @@ typedef enum {
     TR_CITY_MESSAGE_TITLE_TRIUMPHAL_ARCH_COMPLETE,
     TR_CITY_MESSAGE_TEXT_TRIUMPHAL_ARCH_COMPLETE,
     TR_BUILDING_TRIUMPHAL_ARCH_SUPPLIED_BY_ROME,
+    TR_WINDOW_FAST_FORWARD_TITLE,
+    TR_WINDOW_FAST_FORWARD_TICKS_PER_SECOND,
     TRANSLATION_MAX_KEY
 } translation_key;
 
@@ -28,6 +28,7 @@
 #include "figure/roamer_preview.h"
 #include "game/resource.h"
 #include "game/state.h"
+#include "game/time.h"
 #include "graphics/clouds.h"
 #include "graphics/graphics.h"
 #include "graphics/image.h"
@@ -51,6 +52,9 @@
 #include "widget/city/highway.h"
 #include "widget/city/overlay/overlay.h"
 
+#include <stdlib.h>
+#include <string.h>
+
 #define OFFSET(x,y) (x + GRID_SIZE * y)
 
 #define WAREHOUSE_FLAG_FRAMES 9
@@ -89,6 +93,100 @@ static struct {
     float scale;
 } draw_context;
 
+typedef struct {
+    unsigned int stamp;
+    short show_building;
+    short column_height;
+} overlay_values;
+
+// Overlay results per building id, valid while the stamp matches and nothing they depend on has changed
+static struct {
+    overlay_values *buildings;
+    int size;
+    unsigned int stamp;
+    struct {
+        const city_overlay *overlay;
+        int tick;
+        int day;
+        int total_months;
+        unsigned int building_version;
+        unsigned int refresh_version;
+    } key;
+} overlay_cache;
+
+static void update_overlay_cache(void)
+{
+    const city_overlay *overlay = draw_context.overlay;
+    int tick = game_time_tick();
+    int day = game_time_day();
+    int total_months = game_time_total_months();
+    unsigned int building_changes = building_version();
+    unsigned int refresh_version = window_refresh_version();
+    if (overlay_cache.stamp && overlay_cache.key.overlay == overlay && overlay_cache.key.tick == tick &&
+        overlay_cache.key.day == day && overlay_cache.key.total_months == total_months &&
+        overlay_cache.key.building_version == building_changes &&
+        overlay_cache.key.refresh_version == refresh_version) {
+        return;
+    }
+    overlay_cache.key.overlay = overlay;
+    overlay_cache.key.tick = tick;
+    overlay_cache.key.day = day;
+    overlay_cache.key.total_months = total_months;
+    overlay_cache.key.building_version = building_changes;
+    overlay_cache.key.refresh_version = refresh_version;
+    overlay_cache.stamp++;
+    if (!overlay_cache.stamp) {
+        // Wrapped around: old entries could match again
+        if (overlay_cache.buildings) {
+            memset(overlay_cache.buildings, 0, sizeof(overlay_values) * overlay_cache.size);
+        }
+        overlay_cache.stamp = 1;
+    }
+}
+
+static const overlay_values *get_overlay_values(const building *b)
+{
+    if (b->id >= (unsigned int) overlay_cache.size) {
+        int size = building_count();
+        if (size <= (int) b->id) {
+            size = b->id + 1;
+        }
+        overlay_values *buildings = realloc(overlay_cache.buildings, sizeof(overlay_values) * size);
+        if (!buildings) {
+            return 0;
+        }
+        memset(&buildings[overlay_cache.size], 0, sizeof(overlay_values) * (size - overlay_cache.size));
+        overlay_cache.buildings = buildings;
+        overlay_cache.size = size;
+    }
+    overlay_values *values = &overlay_cache.buildings[b->id];
+    if (values->stamp != overlay_cache.stamp) {
+        const city_overlay *overlay = draw_context.overlay;
+        values->show_building = !overlay->show_building || overlay->show_building(b);
+        values->column_height = NO_COLUMN;
+        if (!values->show_building && overlay->get_column_height) {
+            values->column_height = overlay->get_column_height(b);
+        }
+        values->stamp = overlay_cache.stamp;
+    }
+    return values;
+}
+
+static int overlay_shows_building(const building *b)
+{
+    if (!draw_context.overlay->show_building) {
+        return 1;
+    }
+    const overlay_values *values = get_overlay_values(b);
+    return values ? values->show_building : draw_context.overlay->show_building(b);
+}
+
+static int overlay_column_height(const building *b)
+{
+    const overlay_values *values = get_overlay_values(b);
+    return values ? values->column_height : draw_context.overlay->get_column_height(b);
+}
+
 static void init_draw_context(int selected_figure_id, pixel_coordinate *figure_coord, int highlighted_formation)
 {
     draw_context.advance_water_animation = 0;
@@ -113,6 +211,7 @@ static void init_draw_context(int selected_figure_id, pixel_coordinate *figure_c
             draw_context.overlay = ghost_overlay;
         }
     }
+    update_overlay_cache();
 
     // Determine hovered building - only if config enabled and not scrolling
     draw_context.hovered_building_id = 0;
@@ -378,7 +477,7 @@ static void draw_footprint(int x, int y, int grid_offset)
     } else if (building_id && !map_is_bridge(grid_offset)) {
         building *b = building_get(building_id);
 
-        if (!draw_context.overlay->show_building || draw_context.overlay->show_building(b)) {
+        if (overlay_shows_building(b)) {
             image_draw_isometric_footprint_from_draw_tile(map_image_at(grid_offset), x, y, color_mask, draw_context.scale);
         } else {
             if (!building_is_farm(b->type) || is_drawable_farm_corner(grid_offset)) {
@@ -686,7 +785,7 @@ static void draw_building_top(int x, int y, int grid_offset, color_t color_mask)
 {
     building *b = building_get(map_building_at(grid_offset));
 
-    if (!draw_context.overlay->show_building || draw_context.overlay->show_building(b)) {
+    if (overlay_shows_building(b)) {
         image_draw_isometric_top_from_draw_tile(map_image_at(grid_offset), x, y, color_mask, draw_context.scale);
         
         // Specific buildings
@@ -703,7 +802,7 @@ static void draw_building_top(int x, int y, int grid_offset, color_t color_mask)
         return;
     }
     
-    int column_height = draw_context.overlay->get_column_height(b);
+    int column_height = overlay_column_height(b);
     if (column_height == NO_COLUMN) {
         return;
     }
@@ -1014,8 +1113,7 @@ static void draw_animation(int x, int y, int grid_offset)
     building *b = building_get(building_id);
     color_t color_mask = city_draw_get_color_mask(grid_offset, 0);
 
-    int should_draw = b->type == BUILDING_NONE ||
-        !draw_context.overlay->show_building || draw_context.overlay->show_building(b);
+    int should_draw = b->type == BUILDING_NONE || overlay_shows_building(b);
 
     if (img->animation) {
         if (map_property_is_draw_tile(grid_offset) && should_draw) {
@@ -1168,7 +1266,7 @@ static void draw_hippodrome_ornaments(int x, int y, int grid_offset)
         return;
     }
 
-    if (draw_context.overlay->show_building && !draw_context.overlay->show_building(b)) {
+    if (!overlay_shows_building(b)) {
         return;
     }
 
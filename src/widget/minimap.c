@@ -17,6 +17,7 @@
 #include "map/random.h"
 #include "map/terrain.h"
 
+#include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -50,6 +51,20 @@ typedef struct {
     tile_color edges;
     tile_color center;
 } building_tile_color;
+
+typedef struct {
+    int16_t x_view;
+    int16_t y_view;
+    uint8_t figure_color;
+    uint8_t house_size;
+    uint8_t is_dirty;
+    uint8_t random;
+    uint16_t building_type;
+    int terrain;
+    unsigned int building_id;
+} tile_state;
+
+#define MAX_DIRTY_BUILDINGS 64
 static void get_viewport(int *x, int *y, int *width, int *height);
 
 static minimap_functions default_functions = {
@@ -169,6 +184,24 @@ static struct {
     struct {
         int stride;
         color_t *buffer;
+        const minimap_functions *functions;
+        scenario_climate climate;
+        int needs_full_redraw;
+        struct {
+            int x_min;
+            int y_min;
+            int x_max;
+            int y_max;
+        } dirty;
+        struct {
+            unsigned int ids[MAX_DIRTY_BUILDINGS];
+            int count;
+        } dirty_buildings;
+        struct {
+            color_t *pixels;
+            int size;
+        } upload;
+        tile_state tiles[GRID_SIZE * GRID_SIZE];
     } cache;
     const minimap_functions *functions;
     struct {
@@ -309,12 +342,16 @@ static inline void draw_tile(int x_offset, int y_offset, const tile_color *color
     draw_pixel(x_offset + 1, y_offset, colors->right);
 }
 
-static int draw_figure(int x_view, int y_view, int grid_offset)
+static int get_figure_color_type(int grid_offset)
 {
     if (!data.functions->offset.figure) {
-        return 0;
+        return FIGURE_COLOR_NONE;
     }
-    int color_type = data.functions->offset.figure(grid_offset, has_figure_color);
+    return data.functions->offset.figure(grid_offset, has_figure_color);
+}
+
+static int draw_figure(int x_view, int y_view, int color_type)
+{
     if (color_type == FIGURE_COLOR_NONE) {
         return 0;
     }
@@ -442,22 +479,18 @@ static void draw_building(int x_offset, int y_offset, int grid_offset)
     }
 }
 
-static void draw_minimap_tile(int x_view, int y_view, int grid_offset)
+static void draw_minimap_tile(int x_view, int y_view, int grid_offset, const tile_state *tile)
 {
-    if (grid_offset < 0) {
+    if (draw_figure(x_view, y_view, tile->figure_color)) {
         return;
     }
-
-    if (draw_figure(x_view, y_view, grid_offset)) {
-        return;
-    }
-    int terrain = data.functions->offset.terrain(grid_offset);
+    int terrain = tile->terrain;
 
     if (terrain & TERRAIN_BUILDING && !(terrain & (TERRAIN_AQUEDUCT | TERRAIN_WALL))) {
         draw_building(x_view, y_view, grid_offset);
         return;
     }
-    int rand = data.functions->offset.random(grid_offset);
+    int rand = tile->random;
     const tile_color *colors;
     if (terrain & TERRAIN_AQUEDUCT) {
         colors = &minimap_colors.aqueduct;
@@ -483,6 +516,129 @@ static void draw_minimap_tile(int x_view, int y_view, int grid_offset)
     draw_tile(x_view, y_view, colors);
 }
 
+static void get_tile_state(int x_view, int y_view, int grid_offset, tile_state *tile)
+{
+    tile->x_view = x_view;
+    tile->y_view = y_view;
+    tile->figure_color = get_figure_color_type(grid_offset);
+    tile->terrain = data.functions->offset.terrain(grid_offset);
+    tile->random = (uint8_t) data.functions->offset.random(grid_offset);
+    tile->building_id = 0;
+    tile->building_type = BUILDING_NONE;
+    tile->house_size = 0;
+    if (data.functions->building && (tile->terrain & TERRAIN_BUILDING)) {
+        tile->building_id = data.functions->offset.building_id(grid_offset);
+        const building *b = data.functions->building(tile->building_id);
+        tile->building_type = b->type;
+        tile->house_size = b->house_size;
+    }
+}
+
+static int is_valid_grid_offset(int grid_offset)
+{
+    return grid_offset >= 0 && grid_offset < GRID_SIZE * GRID_SIZE;
+}
+
+static void mark_building_dirty(unsigned int building_id)
+{
+    if (!building_id) {
+        return;
+    }
+    for (int i = 0; i < data.cache.dirty_buildings.count; i++) {
+        if (data.cache.dirty_buildings.ids[i] == building_id) {
+            return;
+        }
+    }
+    if (data.cache.dirty_buildings.count == MAX_DIRTY_BUILDINGS) {
+        data.cache.needs_full_redraw = 1;
+        return;
+    }
+    data.cache.dirty_buildings.ids[data.cache.dirty_buildings.count++] = building_id;
+}
+
+static int is_building_dirty(unsigned int building_id)
+{
+    if (!building_id) {
+        return 0;
+    }
+    for (int i = 0; i < data.cache.dirty_buildings.count; i++) {
+        if (data.cache.dirty_buildings.ids[i] == building_id) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void mark_tile_dirty(tile_state *tile, const tile_state *current)
+{
+    mark_building_dirty(tile->building_id);
+    mark_building_dirty(current->building_id);
+    *tile = *current;
+    tile->is_dirty = 1;
+}
+
+static void update_dirty_area(int x_view, int y_view)
+{
+    if (x_view < data.cache.dirty.x_min) {
+        data.cache.dirty.x_min = x_view;
+    }
+    if (x_view + 1 > data.cache.dirty.x_max) {
+        data.cache.dirty.x_max = x_view + 1;
+    }
+    if (y_view < data.cache.dirty.y_min) {
+        data.cache.dirty.y_min = y_view;
+    }
+    if (y_view > data.cache.dirty.y_max) {
+        data.cache.dirty.y_max = y_view;
+    }
+}
+
+static void find_dirty_tile(int x_view, int y_view, int grid_offset)
+{
+    if (!is_valid_grid_offset(grid_offset) || data.cache.needs_full_redraw) {
+        return;
+    }
+    tile_state *tile = &data.cache.tiles[grid_offset];
+    tile_state current;
+    get_tile_state(x_view, y_view, grid_offset, &current);
+    if (tile->x_view != current.x_view || tile->y_view != current.y_view) {
+        // The view lookup changed (e.g. rotation), so pixels may now belong to different tiles
+        data.cache.needs_full_redraw = 1;
+        return;
+    }
+    if (tile->figure_color != current.figure_color || tile->terrain != current.terrain ||
+        tile->random != current.random || tile->building_id != current.building_id || tile->building_type != current.building_type ||
+        tile->house_size != current.house_size) {
+        mark_tile_dirty(tile, &current);
+    } else {
+        tile->is_dirty = 0;
+    }
+}
+
+static void draw_dirty_tile(int x_view, int y_view, int grid_offset)
+{
+    if (!is_valid_grid_offset(grid_offset)) {
+        return;
+    }
+    const tile_state *tile = &data.cache.tiles[grid_offset];
+    if (!tile->is_dirty && !is_building_dirty(tile->building_id)) {
+        return;
+    }
+    draw_minimap_tile(x_view, y_view, grid_offset, tile);
+    update_dirty_area(x_view, y_view);
+}
+
+static void redraw_tile(int x_view, int y_view, int grid_offset)
+{
+    if (!is_valid_grid_offset(grid_offset)) {
+        return;
+    }
+    tile_state *tile = &data.cache.tiles[grid_offset];
+    get_tile_state(x_view, y_view, grid_offset, tile);
+    tile->is_dirty = 0;
+    draw_minimap_tile(x_view, y_view, grid_offset, tile);
+}
+
 static void draw_viewport_rectangle(void)
 {
     int x_offset = (int) ((2 * (data.viewport.x - data.minimap.x) - 2 / 30) / data.minimap.scale);
@@ -511,8 +667,19 @@ static void prepare_minimap_cache(void)
         data.minimap.y = (VIEW_Y_MAX - data.minimap.height) / 2;
 
         graphics_renderer()->create_custom_image(CUSTOM_IMAGE_MINIMAP, data.minimap.width * 2, data.minimap.height, 0);
+        data.cache.buffer = 0;
+    }
+    if (!data.cache.buffer) {
+        // The renderer hands out a fresh buffer on every call, so only ask for one when the texture is new
+        data.cache.buffer = graphics_renderer()->get_custom_image_buffer(CUSTOM_IMAGE_MINIMAP, &data.cache.stride);
+        data.cache.needs_full_redraw = 1;
+    }
+    scenario_climate climate = data.functions->climate();
+    if (data.cache.functions != data.functions || data.cache.climate != climate) {
+        data.cache.functions = data.functions;
+        data.cache.climate = climate;
+        data.cache.needs_full_redraw = 1;
     }
-    data.cache.buffer = graphics_renderer()->get_custom_image_buffer(CUSTOM_IMAGE_MINIMAP, &data.cache.stride);
 }
 
 static void clear_minimap(void)
@@ -520,6 +687,34 @@ static void clear_minimap(void)
     memset(data.cache.buffer, 0, sizeof(color_t) * data.minimap.height * data.cache.stride);
 }
 
+static void upload_dirty_area(void)
+{
+    int x_min = calc_bound(data.cache.dirty.x_min, 0, data.minimap.width * 2 - 1);
+    int x_max = calc_bound(data.cache.dirty.x_max, 0, data.minimap.width * 2 - 1);
+    int y_min = calc_bound(data.cache.dirty.y_min, 0, data.minimap.height - 1);
+    int y_max = calc_bound(data.cache.dirty.y_max, 0, data.minimap.height - 1);
+    if (x_min > x_max || y_min > y_max) {
+        return;
+    }
+    int width = x_max - x_min + 1;
+    int height = y_max - y_min + 1;
+    if (width * height > data.cache.upload.size) {
+        color_t *pixels = realloc(data.cache.upload.pixels, sizeof(color_t) * width * height);
+        if (!pixels) {
+            graphics_renderer()->update_custom_image(CUSTOM_IMAGE_MINIMAP);
+            return;
+        }
+        data.cache.upload.pixels = pixels;
+        data.cache.upload.size = width * height;
+    }
+    for (int y = 0; y < height; y++) {
+        memcpy(&data.cache.upload.pixels[y * width], &data.cache.buffer[(y_min + y) * data.cache.stride + x_min],
+            sizeof(color_t) * width);
+    }
+    graphics_renderer()->update_custom_image_from(CUSTOM_IMAGE_MINIMAP, data.cache.upload.pixels,
+        x_min, y_min, width, height);
+}
+
 void widget_minimap_update(const minimap_functions *functions)
 {
     data.functions = functions ? functions : &default_functions;
@@ -527,10 +722,49 @@ void widget_minimap_update(const minimap_functions *functions)
     if (!data.cache.buffer) {
         return;
     }
-    clear_minimap();
-    minimap_colors.climate = &CLIMATE_VARIANTS[data.functions->climate()];
-    foreach_map_tile(draw_minimap_tile);
+    minimap_colors.climate = &CLIMATE_VARIANTS[data.cache.climate];
+    if (!data.cache.needs_full_redraw) {
+        data.cache.dirty_buildings.count = 0;
+        foreach_map_tile(find_dirty_tile);
+    }
+    if (data.cache.needs_full_redraw) {
+        clear_minimap();
+        foreach_map_tile(redraw_tile);
+        graphics_renderer()->update_custom_image(CUSTOM_IMAGE_MINIMAP);
+        data.cache.needs_full_redraw = 0;
+        return;
+    }
+    data.cache.dirty.x_min = data.cache.dirty.y_min = INT_MAX;
+    data.cache.dirty.x_max = data.cache.dirty.y_max = INT_MIN;
+    foreach_map_tile(draw_dirty_tile);
+    upload_dirty_area();
+}
+
+const color_t *widget_minimap_get_pixels(int *width, int *height, int *stride)
+{
+    if (!data.cache.buffer) {
+        return 0;
+    }
+    *width = data.minimap.width * 2;
+    *height = data.minimap.height;
+    *stride = data.cache.stride;
+    return data.cache.buffer;
+}
+
+int widget_minimap_set_pixels(const minimap_functions *functions, const color_t *pixels, int width, int height)
+{
+    data.functions = functions ? functions : &default_functions;
+    prepare_minimap_cache();
+    if (!data.cache.buffer || width != data.minimap.width * 2 || height != data.minimap.height) {
+        return 0;
+    }
+    for (int y = 0; y < height; y++) {
+        memcpy(&data.cache.buffer[y * data.cache.stride], &pixels[y * width], sizeof(color_t) * width);
+    }
     graphics_renderer()->update_custom_image(CUSTOM_IMAGE_MINIMAP);
+    // The tile states no longer match the pixels, so the next update has to redraw everything
+    data.cache.needs_full_redraw = 1;
+    return 1;
 }
 
 void widget_minimap_draw(int x_offset, int y_offset, int width, int height)
@@ -3,6 +3,7 @@
 
 #include "building/building.h"
 #include "figure/figure.h"
+#include "graphics/color.h"
 #include "input/mouse.h"
 #include "scenario/property.h"
 
@@ -28,6 +29,22 @@ void widget_minimap_invalidate(void);
 
 void widget_minimap_update(const minimap_functions *functions);
 
+/**
+ * Returns the rendered minimap, to keep a copy of it
+ * @param width Set to the width in pixels
+ * @param height Set to the height in pixels
+ * @param stride Set to the row length in pixels
+ * @return The pixels, or 0 if the minimap was never rendered
+ */
+const color_t *widget_minimap_get_pixels(int *width, int *height, int *stride);
+
+/**
+ * Replaces the rendered minimap with a copy taken from widget_minimap_get_pixels
+ * @param functions The functions that describe the map the copy was taken from
+ * @return 1 if the copy matches the map size and was shown, 0 otherwise
+ */
+int widget_minimap_set_pixels(const minimap_functions *functions, const color_t *pixels, int width, int height);
+
 void widget_minimap_draw(int x_offset, int y_offset, int width, int height);
 
 void widget_minimap_draw_decorated(int x_offset, int y_offset, int width, int height);
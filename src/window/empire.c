@@ -24,6 +24,7 @@
 #include "graphics/image_button.h"
 #include "graphics/lang_text.h"
 #include "graphics/panel.h"
+#include "graphics/renderer.h"
 #include "graphics/screen.h"
 #include "graphics/scrollbar.h"
 #include "graphics/text.h"
@@ -69,6 +70,10 @@
 #define TRADE_PULSE_DOT_MS 180
 #define TRADE_DOT_ANIMATION_SCALE 160
 
+#define MAP_LAYER_STATIC 1
+#define MAP_LAYER_ANIMATED 2
+#define MAP_LAYER_ALL (MAP_LAYER_STATIC | MAP_LAYER_ANIMATED)
+
 #define FONT_SPACE_WIDTH font_definition_for(FONT_NORMAL_GREEN)->space_width
 #define FONT_HEIGHT_NORMAL font_definition_for(FONT_NORMAL_GREEN)->line_height
 #define FONT_HEIGHT_LARGE font_definition_for(FONT_LARGE_BLACK)->line_height
@@ -265,6 +270,21 @@ static px_point trade_amount_px_offsets[5] = {
     { 4, 6 },
 };
 
+// Everything the cached map layers depend on
+typedef struct {
+    int x_offset;
+    int y_offset;
+    int clip_x;
+    int clip_y;
+    int clip_width;
+    int clip_height;
+    int image_id;
+    int atlas_id;
+    int is_expanded;
+    unsigned int objects_version;
+    unsigned int target_generation;
+} map_cache_key;
+
 static struct {
     unsigned int selected_button;
     int selected_city;
@@ -303,6 +323,13 @@ static struct {
         } border_btn;
     } sidebar;
     int trade_route_anim_start;
+    struct {
+        int texture_id;
+        int is_valid;
+        map_cache_key key;
+        uint8_t *open_cities;
+        int num_cities;
+    } map_cache;
 } data = { 0, 1 , 0 };
 
 // -------------------------------------------------------------------------------------------------------
@@ -332,6 +359,7 @@ static void init(void)
     data.focus_button_id = 0;
     window_empire_collect_trade_edges();
     data.trade_route_anim_start = time_get_millis();
+    data.map_cache.is_valid = 0;
 }
 
 static void setup_sidebar(void)
@@ -800,11 +828,8 @@ void window_empire_collect_trade_edges(void)
     }
 }
 
-void window_empire_draw_static_trade_waypoints(const empire_object *route_object, int x_offset, int y_offset)
+static void draw_trade_route_dots(const empire_object *route_object, int x_offset, int y_offset)
 {
-    if (scenario_empire_id() != SCENARIO_CUSTOM_EMPIRE) {
-        return;
-    }
     int is_sea_route = route_object->type == EMPIRE_OBJECT_SEA_TRADE_ROUTE;
 
     int image_id = assets_get_image_id("UI", is_sea_route ? "SeaRouteDot" : "LandRouteDot");
@@ -838,6 +863,14 @@ void window_empire_draw_static_trade_waypoints(const empire_object *route_object
 
         edge->drawn = 1; // mark as processed for this frame
     }
+}
+
+void window_empire_draw_static_trade_waypoints(const empire_object *route_object, int x_offset, int y_offset)
+{
+    if (scenario_empire_id() != SCENARIO_CUSTOM_EMPIRE) {
+        return;
+    }
+    draw_trade_route_dots(route_object, x_offset, y_offset);
     if (config_get(CONFIG_UI_ANIMATE_TRADE_ROUTES)) {
         window_empire_draw_trade_route_pulses(route_object, x_offset, y_offset);
     }
@@ -1412,7 +1445,22 @@ static int draw_images_at_interval(int image_id, int x_draw_offset, int y_draw_o
     return remaining;
 }
 
-void window_empire_draw_border(const empire_object *border, int x_offset, int y_offset)
+static int draw_border_segment(const empire_object *animated_obj, int image_id, int x_offset, int y_offset,
+    int start_x, int start_y, int end_x, int end_y, int spacing, int remaining, int layers)
+{
+    int next_remaining = draw_images_at_interval((layers & MAP_LAYER_STATIC) ? image_id : 0, x_offset, y_offset,
+        start_x, start_y, end_x, end_y, spacing, remaining);
+    const image *img = image_get(image_id);
+    if ((layers & MAP_LAYER_ANIMATED) && img->animation && img->animation->speed_id) {
+        int animation_offset = empire_object_update_animation(animated_obj, image_id);
+        draw_images_at_interval(image_id + animation_offset,
+            x_offset + img->animation->sprite_offset_x, y_offset + img->animation->sprite_offset_y,
+            start_x, start_y, end_x, end_y, spacing, remaining);
+    }
+    return next_remaining;
+}
+
+static void draw_border(const empire_object *border, int x_offset, int y_offset, int layers)
 {
     int first = 0;
     int first_edge_id = empire_object_get_next_in_order(border->id, &first);
@@ -1441,19 +1489,9 @@ void window_empire_draw_border(const empire_object *border, int x_offset, int y_
         if (obj->type != EMPIRE_OBJECT_BORDER_EDGE) {
             break;
         }
-        int animation_offset = 0;
-        int x = x_offset;
-        int y = y_offset;
         if (image_id) {
-            const image *img = image_get(image_id);
-            draw_images_at_interval(image_id, x, y, last_x, last_y, obj->x, obj->y, border->width, remaining);
-            if (img->animation && img->animation->speed_id) {
-                animation_offset = empire_object_update_animation(obj, image_id);
-                x += img->animation->sprite_offset_x;
-                y += img->animation->sprite_offset_y;
-            }
-            remaining = draw_images_at_interval(image_id + animation_offset, x, y, last_x, last_y, obj->x, obj->y,
-                border->width, remaining);
+            remaining = draw_border_segment(obj, image_id, x_offset, y_offset, last_x, last_y, obj->x, obj->y,
+                border->width, remaining, layers);
         } else {
             remaining = border->width;
         }
@@ -1464,17 +1502,53 @@ void window_empire_draw_border(const empire_object *border, int x_offset, int y_
     if (!image_id) {
         return;
     }
-    int animation_offset = 0;
+    draw_border_segment(border, image_id, x_offset, y_offset, last_x, last_y, first_edge->x, first_edge->y,
+        border->width, remaining, layers);
+}
+
+void window_empire_draw_border(const empire_object *border, int x_offset, int y_offset)
+{
+    draw_border(border, x_offset, y_offset, MAP_LAYER_ALL);
+}
+
+static void get_object_draw_info(const empire_object *obj, int *x, int *y, int *image_id)
+{
+    if (scenario_empire_is_expanded()) {
+        *x = obj->expanded.x;
+        *y = obj->expanded.y;
+        *image_id = obj->expanded.image_id;
+    } else {
+        *x = obj->x;
+        *y = obj->y;
+        *image_id = obj->image_id;
+    }
+}
+
+static void draw_ornament(const empire_object *obj, int layers)
+{
+    int x, y, image_id;
+    get_object_draw_info(obj, &x, &y, &image_id);
+    if (image_id < 0) {
+        image_id = assets_lookup_image_id(ASSET_FIRST_ORNAMENT) - 1 - image_id;
+    }
     const image *img = image_get(image_id);
+    if (layers & MAP_LAYER_STATIC) {
+        image_draw(image_id, data.x_draw_offset + x, data.y_draw_offset + y, COLOR_MASK_NONE, SCALE_NONE);
+    }
+    if (!(layers & MAP_LAYER_ANIMATED)) {
+        return;
+    }
     if (img->animation && img->animation->speed_id) {
-        animation_offset = empire_object_update_animation(border, image_id);
+        int new_animation = empire_object_update_animation(obj, image_id);
+        image_draw(image_id + new_animation,
+            data.x_draw_offset + x + img->animation->sprite_offset_x,
+            data.y_draw_offset + y + img->animation->sprite_offset_y,
+            COLOR_MASK_NONE, SCALE_NONE);
     }
-    draw_images_at_interval(image_id, x_offset, y_offset, last_x, last_y, first_edge->x, first_edge->y,
-        border->width, remaining);
-    if (animation_offset) {
-        draw_images_at_interval(image_id + animation_offset,
-                x_offset + img->animation->sprite_offset_x, y_offset + img->animation->sprite_offset_y,
-                last_x, last_y, first_edge->x, first_edge->y, border->width, remaining);
+    // Manually fix the Hagia Sophia. Drawn with the animated layer so it stays above the animation
+    if (obj->image_id == 8122) {
+        image_draw(assets_lookup_image_id(ASSET_HAGIA_SOPHIA_FIX),
+            data.x_draw_offset + x, data.y_draw_offset + y, COLOR_MASK_NONE, SCALE_NONE);
     }
 }
 
@@ -1488,19 +1562,17 @@ static void draw_empire_object(const empire_object *obj)
             return; // dont draw the icon if route is closed
         }
     }
-    int x, y, image_id;
-    if (scenario_empire_is_expanded()) {
-        x = obj->expanded.x;
-        y = obj->expanded.y;
-        image_id = obj->expanded.image_id;
-    } else {
-        x = obj->x;
-        y = obj->y;
-        image_id = obj->image_id;
-    }
+    // The static parts of borders and ornaments are drawn with the cached map layers
     if (obj->type == EMPIRE_OBJECT_BORDER) {
-        window_empire_draw_border(obj, data.x_draw_offset, data.y_draw_offset);
+        draw_border(obj, data.x_draw_offset, data.y_draw_offset, MAP_LAYER_ANIMATED);
+        return;
     }
+    if (obj->type == EMPIRE_OBJECT_ORNAMENT) {
+        draw_ornament(obj, MAP_LAYER_ANIMATED);
+        return;
+    }
+    int x, y, image_id;
+    get_object_draw_info(obj, &x, &y, &image_id);
     if (obj->type == EMPIRE_OBJECT_CITY) {
         const empire_city *city = empire_city_get(empire_city_get_for_object(obj->id));
         if (city->type == EMPIRE_CITY_DISTANT_FOREIGN ||
@@ -1532,11 +1604,6 @@ static void draw_empire_object(const empire_object *obj)
             return;
         }
     }
-    if (obj->type == EMPIRE_OBJECT_ORNAMENT) {
-        if (image_id < 0) {
-            image_id = assets_lookup_image_id(ASSET_FIRST_ORNAMENT) - 1 - image_id;
-        }
-    }
     if (obj->type == EMPIRE_OBJECT_CITY) {
         if (empire_object_get_full(obj->id)->city_type == EMPIRE_CITY_TRADE && obj->future_trade_after_icon) {
             image_id = empire_city_get_icon_image_id(obj->future_trade_after_icon);
@@ -1595,16 +1662,29 @@ static void draw_empire_object(const empire_object *obj)
     }
 }
 
-static void empire_draw_object_trade_route(const empire_object *obj)
+static void draw_static_ornament(const empire_object *obj)
 {
-    if (obj->type == EMPIRE_OBJECT_LAND_TRADE_ROUTE || obj->type == EMPIRE_OBJECT_SEA_TRADE_ROUTE) {
-        if (scenario_empire_id() == SCENARIO_CUSTOM_EMPIRE) {
-            if (empire_city_is_trade_route_open(obj->trade_route_id)) {
-                window_empire_draw_static_trade_waypoints(obj, data.x_draw_offset, data.y_draw_offset);
-            }
-        }
+    draw_ornament(obj, MAP_LAYER_STATIC);
+}
+
+static void draw_static_border(const empire_object *obj)
+{
+    draw_border(obj, data.x_draw_offset, data.y_draw_offset, MAP_LAYER_STATIC);
+}
+
+static void draw_static_trade_route(const empire_object *obj)
+{
+    if (scenario_empire_id() == SCENARIO_CUSTOM_EMPIRE && empire_city_is_trade_route_open(obj->trade_route_id)) {
+        draw_trade_route_dots(obj, data.x_draw_offset, data.y_draw_offset);
+    }
+}
+
+static void draw_trade_route_pulses(const empire_object *obj)
+{
+    if (scenario_empire_id() == SCENARIO_CUSTOM_EMPIRE && empire_city_is_trade_route_open(obj->trade_route_id) &&
+        config_get(CONFIG_UI_ANIMATE_TRADE_ROUTES)) {
+        window_empire_draw_trade_route_pulses(obj, data.x_draw_offset, data.y_draw_offset);
     }
-    return;
 }
 
 static void animation_draw_scaled(const image *img, int image_id, int new_animation, int x, int y, color_t color, int draw_scale_percent)
@@ -1644,6 +1724,83 @@ void empire_reset_route_drawn_flags(void)
     }
 }
 
+// Compares which cities are open against the ones the cached map was drawn with, and stores the current ones
+static int update_open_trade_routes(void)
+{
+    int num_cities = empire_city_get_array_size();
+    int changed = 0;
+    if (num_cities != data.map_cache.num_cities) {
+        uint8_t *open_cities = num_cities ? realloc(data.map_cache.open_cities, num_cities) : 0;
+        if (num_cities && !open_cities) {
+            return 1;
+        }
+        if (!num_cities) {
+            free(data.map_cache.open_cities);
+        }
+        data.map_cache.open_cities = open_cities;
+        data.map_cache.num_cities = num_cities;
+        changed = 1;
+    }
+    for (int i = 0; i < num_cities; i++) {
+        const empire_city *city = empire_city_get(i);
+        uint8_t is_open = city->in_use && city->is_open;
+        if (changed || data.map_cache.open_cities[i] != is_open) {
+            data.map_cache.open_cities[i] = is_open;
+            changed = 1;
+        }
+    }
+    return changed;
+}
+
+static void draw_static_map_layers(void)
+{
+    image_draw(empire_get_image_id(), data.x_draw_offset, data.y_draw_offset, COLOR_MASK_NONE, SCALE_NONE);
+    // Reset all edge drawn flags, so that edges shared by routes are only drawn once
+    empire_reset_route_drawn_flags();
+    // The static parts of ornaments and borders end up below every other object, not in object id order
+    empire_object_foreach_of_type(draw_static_ornament, EMPIRE_OBJECT_ORNAMENT);
+    empire_object_foreach_of_type(draw_static_border, EMPIRE_OBJECT_BORDER);
+    empire_object_foreach_of_type(draw_static_trade_route, EMPIRE_OBJECT_SEA_TRADE_ROUTE);
+    empire_object_foreach_of_type(draw_static_trade_route, EMPIRE_OBJECT_LAND_TRADE_ROUTE);
+}
+
+static void draw_map_layers(int x, int y, int width, int height)
+{
+    map_cache_key key;
+    memset(&key, 0, sizeof(key));
+    key.x_offset = data.x_draw_offset;
+    key.y_offset = data.y_draw_offset;
+    key.clip_x = x;
+    key.clip_y = y;
+    key.clip_width = width;
+    key.clip_height = height;
+    key.image_id = empire_get_image_id();
+    key.atlas_id = image_get(key.image_id)->atlas.id;
+    key.is_expanded = scenario_empire_is_expanded();
+    key.objects_version = empire_object_version();
+    key.target_generation = graphics_renderer_target_generation();
+
+    int routes_changed = update_open_trade_routes();
+    int is_same_view = !routes_changed && memcmp(&key, &data.map_cache.key, sizeof(key)) == 0;
+    if (is_same_view && data.map_cache.is_valid) {
+        graphics_draw_from_image(data.map_cache.texture_id, x, y);
+        return;
+    }
+    draw_static_map_layers();
+    // Only keep views that last for more than one frame, so scrolling does not copy the map every frame
+    data.map_cache.is_valid = 0;
+    if (is_same_view) {
+        int texture_id = graphics_save_to_image(data.map_cache.texture_id, x, y, width, height);
+        if (texture_id) {
+            data.map_cache.texture_id = texture_id;
+            data.map_cache.is_valid = 1;
+        }
+        // Saving switches render targets, which drops the clip rectangle
+        graphics_set_clip_rectangle(x, y, width, height);
+    }
+    data.map_cache.key = key;
+}
+
 static void draw_map(void)
 {
     // Recalculate inner bounds (same as draw_background)
@@ -1651,25 +1808,27 @@ static void draw_map(void)
     int map_clip_y_min = data.y_min + WIDTH_BORDER;
     int map_clip_x_max = data.sidebar.x_min;  // Stop before sidebar starts
     int map_clip_y_max = data.y_max - BOTTOM_PANEL_HEIGHT;
+    int map_clip_width = map_clip_x_max - map_clip_x_min;
+    int map_clip_height = map_clip_y_max - map_clip_y_min;
 
-    graphics_set_clip_rectangle(map_clip_x_min, map_clip_y_min, map_clip_x_max - map_clip_x_min, map_clip_y_max - map_clip_y_min);
-    // Reset all edge drawn flags for this frame
-    empire_reset_route_drawn_flags();
+    graphics_set_clip_rectangle(map_clip_x_min, map_clip_y_min, map_clip_width, map_clip_height);
 
-    empire_set_viewport(map_clip_x_max - map_clip_x_min, map_clip_y_max - map_clip_y_min);
+    empire_set_viewport(map_clip_width, map_clip_height);
 
     data.x_draw_offset = map_clip_x_min;
     data.y_draw_offset = map_clip_y_min;
     empire_adjust_scroll(&data.x_draw_offset, &data.y_draw_offset);
 
-    image_draw(empire_get_image_id(), data.x_draw_offset, data.y_draw_offset, COLOR_MASK_NONE, SCALE_NONE);
     if (data.trade_route_anim_start == 0) {
         data.trade_route_anim_start = time_get_millis();
     }
 
+    // The map image, ornaments, borders and trade route paths only change with the view or the empire objects
+    draw_map_layers(map_clip_x_min, map_clip_y_min, map_clip_width, map_clip_height);
+
     empire_object_foreach(draw_empire_object);
-    empire_object_foreach_of_type(empire_draw_object_trade_route, EMPIRE_OBJECT_SEA_TRADE_ROUTE);
-    empire_object_foreach_of_type(empire_draw_object_trade_route, EMPIRE_OBJECT_LAND_TRADE_ROUTE);
+    empire_object_foreach_of_type(draw_trade_route_pulses, EMPIRE_OBJECT_SEA_TRADE_ROUTE);
+    empire_object_foreach_of_type(draw_trade_route_pulses, EMPIRE_OBJECT_LAND_TRADE_ROUTE);
     empire_object_foreach_of_type(draw_empire_object, EMPIRE_OBJECT_LAND_TRADE_ROUTE);
     empire_object_foreach_of_type(draw_empire_object, EMPIRE_OBJECT_SEA_TRADE_ROUTE);
     empire_object_foreach_of_type(draw_empire_object, EMPIRE_OBJECT_CITY);
@@ -0,0 +1,48 @@
+#include "fast_forward.h"
+
+#include "game/fast_forward.h"
+#include "game/time.h"
+#include "graphics/graphics.h"
+#include "graphics/lang_text.h"
+#include "graphics/panel.h"
+#include "graphics/text.h"
+#include "graphics/window.h"
+#include "input/input.h"
+#include "translation/translation.h"
+#include "window/city.h"
+
+static void draw_foreground(void)
+{
+    graphics_in_dialog();
+    outer_panel_draw(128, 160, 24, 8);
+    text_draw_centered(translation_for(TR_WINDOW_FAST_FORWARD_TITLE), 128, 172, 384, FONT_LARGE_BLACK, 0);
+    lang_text_draw_month_year_max_width(game_time_month(), game_time_year(), 144, 212, 352, FONT_NORMAL_BLACK, 0);
+    int width = text_draw(translation_for(TR_WINDOW_FAST_FORWARD_TICKS_PER_SECOND), 144, 236, FONT_NORMAL_BLACK, 0);
+    text_draw_number(game_fast_forward_ticks_per_second(), '@', " ", 144 + width, 236, FONT_NORMAL_BLACK, 0);
+    graphics_reset_dialog();
+}
+
+static void handle_input(const mouse *m, const hotkeys *h)
+{
+    if (!game_fast_forward_is_active()) {
+        // Also reached when returning from a window that interrupted fast forwarding
+        window_city_show();
+    } else if (input_go_back_requested(m, h)) {
+        game_fast_forward_stop();
+        window_city_show();
+    }
+}
+
+void window_fast_forward_show(int months)
+{
+    window_type window = {
+        WINDOW_FAST_FORWARD,
+        window_draw_underlying_window,
+        draw_foreground,
+        handle_input
+    };
+    game_fast_forward_start(months);
+    if (game_fast_forward_is_active()) {
+        window_show(&window);
+    }
+}
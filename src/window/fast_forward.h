@@ -0,0 +1,6 @@
+#ifndef WINDOW_FAST_FORWARD_H
+#define WINDOW_FAST_FORWARD_H
+
+void window_fast_forward_show(int months);
+
+#endif // WINDOW_FAST_FORWARD_H
@@ -339,13 +339,26 @@ static void draw_mission_info(int x_offset, int y_offset, int box_size)
     text_draw_ellipsized(text, x_offset, y_offset, box_size, FONT_NORMAL_BLACK, 0);
 }
 
+static unsigned int get_selected_file_modified_time(void)
+{
+    for (int i = 0; i < data.filtered_file_list.num_files; i++) {
+        if (strcmp(data.filtered_file_list.files[i].name, data.selected_file) == 0) {
+            return data.filtered_file_list.files[i].modified_time;
+        }
+    }
+    return 0;
+}
+
 static void draw_background(void)
 {
     window_draw_underlying_window();
     if (*data.selected_file) {
         const char *filename = dir_get_file_at_location(data.selected_file, data.file_data->location);
         if (filename && data.type != FILE_TYPE_EMPIRE_IMAGE) {
-            if (data.type == FILE_TYPE_SAVED_GAME) {
+            unsigned int modified_time = get_selected_file_modified_time();
+            if (data.type == FILE_TYPE_SAVED_GAME && modified_time) {
+                data.savegame_info_status = game_file_io_read_saved_game_summary(filename, modified_time, &data.info);
+            } else if (data.type == FILE_TYPE_SAVED_GAME) {
                 data.savegame_info_status = game_file_io_read_saved_game_info(filename, 0, &data.info);
             } else {
                 data.savegame_info_status = game_file_io_read_scenario_info(filename, &data.info);